@@ -143,26 +143,34 @@ solution {"Spadengine"}
 				"../ThirdParty/stb_image/Include/",
 				"../ThirdParty/assimp/include/",
 				"../Samples/Sample/Include/"}
-		links { "SDL2", "Core", "Renderer", "glad","dl","assimp", "Resources" }
-
-
---	project "ECSample"
---		kind "ConsoleApp"
---		language "C++"
---		location "../Samples/ECSample"
---		files {"../Samples/ECSample/**.cpp"}
---		includedirs {"../Core/Include/",
---				"../Renderer/Include/",
---				"../Game/Include/",
---				"../Resources/Include/",
---				"../ThirdParty/freetype/include/",
---				"../ThirdParty/freetype/include/freetype/",
---				"../ThirdParty/SDL/include/",
---				"../ThirdParty/glm/include/",
---				"../ThirdParty/glad/Include/",
---				"../ThirdParty/stb_image/Include/",
---				"../ThirdParty/assimp/include/"}
---		links {"Core", "Game", "Renderer", "Resources","SDL2","glad","dl","assimp", "freetype"}
+		links { "SDL2", "Core", "Renderer", "glad","dl","assimp", "Resources", "pthread" }
+
+
+	project "ECSample"
+		kind "ConsoleApp"
+		language "C++"
+		location "../Samples/ECSample"
+		files {"../Samples/ECSample/**.cpp"}
+		includedirs {"../Core/Include/",
+				"../Core/Include/Core/Memory/",
+				"../Game/Include/",
+				"../ThirdParty/bulletphysics/include/",
+				"../ThirdParty/bulletphysics/include/Bullet/",
+				"../ThirdParty/SDL/include/",
+				"../ThirdParty/glm/include/"}
+		links {"Game", "Core", "Bullet", "SDL2", "pthread"}
+
+	project "QueueSample"
+		kind "ConsoleApp"
+		language "C++"
+		location "../Samples/QueueSample"
+		files {"../Samples/QueueSample/**.cpp"}
+		includedirs {"../Core/Include/",
+				"../Renderer/Include/",
+				"../ThirdParty/glad/Include/",
+				"../ThirdParty/SDL/include/",
+				"../ThirdParty/glm/include/"}
+		links {"Renderer", "Core", "glad", "SDL2", "pthread"}
 
 	project "RenderSample"
 		kind "ConsoleApp"
@@ -179,7 +187,7 @@ solution {"Spadengine"}
 				"../ThirdParty/glad/Include/",
 				"../ThirdParty/stb_image/Include/",
 				"../ThirdParty/assimp/include/"}
-		links {"Core", "Game" ,"Resources","Renderer", "SDL2","glad","dl","assimp","freetype"}
+		links {"Core", "Game" ,"Resources","Renderer", "SDL2","glad","dl","assimp","freetype","pthread"}
 
 	project "PowerSample"
 		kind "ConsoleApp"
@@ -197,7 +205,7 @@ solution {"Spadengine"}
 				"../ThirdParty/glm/include/",
 				"../ThirdParty/SDL/include/",
 				"../ThirdParty/stb_image/Include/"}		
-		links {"Spade","Game","Renderer","HID","Resources","Core","assimp","glad", "dl", "SDL2", "freetype"}
+		links {"Spade","Game","Renderer","HID","Resources","Core","assimp","glad", "dl", "SDL2", "freetype", "pthread"}
 
 	project "SceneSample"
 		kind "ConsoleApp"
@@ -221,6 +229,6 @@ solution {"Spadengine"}
 				"../ThirdParty/glm/include/",
 				"../ThirdParty/SDL/include/",
 				"../ThirdParty/stb_image/Include/"}
-		links {"Spade","Game","Audio","Renderer","HID","Resources","Core","assimp","glad", "dl", "SDL2","Bullet","portaudio","freetype"}
+		links {"Spade","Game","Audio","Renderer","HID","Resources","Core","assimp","glad", "dl", "SDL2","Bullet","portaudio","freetype","pthread"}
 	 
 	
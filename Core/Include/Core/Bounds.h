@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cfloat>
+#include <cstddef>
+
+#include "Core/Math.h"
+#include "Core/Types.h"
+
+namespace sge
+{
+	/** \brief Axis aligned bounding box. */
+	struct AABB
+	{
+		math::vec3 min;
+		math::vec3 max;
+
+		/** \brief Box that contains nothing, grow() it to add points. */
+		static AABB empty()
+		{
+			AABB box = { math::vec3(FLT_MAX), math::vec3(-FLT_MAX) };
+			return box;
+		}
+
+		bool isEmpty() const
+		{
+			return min.x > max.x;
+		}
+
+		void grow(const math::vec3& point)
+		{
+			min = math::min(min, point);
+			max = math::max(max, point);
+		}
+
+		void grow(const AABB& box)
+		{
+			min = math::min(min, box.min);
+			max = math::max(max, box.max);
+		}
+
+		/** \brief Box around this box after the transform. */
+		AABB transform(const math::mat4& matrix) const;
+	};
+
+	/** \brief Bounding sphere, 16 bytes so arrays of them can be loaded straight into SIMD registers. */
+	struct BoundingSphere
+	{
+		math::vec3 center;
+		float radius;
+
+		/** \brief Sphere around the box. */
+		static BoundingSphere fromAABB(const AABB& box)
+		{
+			BoundingSphere sphere = { (box.min + box.max) * 0.5f, math::length(box.max - box.min) * 0.5f };
+			return sphere;
+		}
+
+		/** \brief Sphere around this sphere after the transform, scaled by the largest axis scale. */
+		BoundingSphere transform(const math::mat4& matrix) const;
+	};
+
+	/** \brief The six planes of a view projection, normals pointing inside. */
+	class Frustum
+	{
+	public:
+		Frustum() {};
+
+		/** \brief Extracts the planes from the rows of the matrix (Gribb & Hartmann). */
+		explicit Frustum(const math::mat4& viewProj);
+
+		/** \brief True if some part of the box may be inside. */
+		bool intersects(const AABB& box) const;
+
+		bool intersects(const BoundingSphere& sphere) const;
+
+		/** \brief Tests many spheres, four at a time with SSE where it's available.
+		*
+		* \param uint8* visible : Set to 1 for each sphere that may be inside and to 0 for the rest.
+		* \return Number of visible spheres.
+		*/
+		size_t cull(const BoundingSphere* spheres, size_t count, uint8* visible) const;
+
+	private:
+		math::vec4 planes[6];	/**< xyz normal and w distance, dot(normal, p) + w >= 0 inside. */
+	};
+}
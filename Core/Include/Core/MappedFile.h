@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace sge
+{
+	/** \brief Read-only view of a whole file.
+	*
+	* The file is memory mapped where the platform supports it, so pages are only read
+	* when they are touched. Otherwise the file is read into memory in one go.
+	*/
+	class MappedFile
+	{
+	public:
+		MappedFile();
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		void operator=(const MappedFile&) = delete;
+
+		/** \brief Opens and maps a file, closing the previous one.
+		*
+		* \param const std::string& path : Path to the file.
+		* \return True if the file could be opened.
+		*/
+		bool open(const std::string& path);
+
+		void close();
+
+		const void* getData() const
+		{
+			return data;
+		}
+
+		size_t getSize() const
+		{
+			return size;
+		}
+
+		/** \brief Whether the data is a memory mapping instead of a copy. */
+		bool isMapped() const
+		{
+			return mapped;
+		}
+
+	private:
+		bool map(const std::string& path);
+		bool read(const std::string& path);
+
+		const void* data;
+		size_t size;
+		bool mapped;
+
+		std::vector<char> buffer; /**< File contents when mapping isn't available. */
+
+#if defined(_WIN32)
+		void* fileHandle;
+		void* mappingHandle;
+#endif
+	};
+}
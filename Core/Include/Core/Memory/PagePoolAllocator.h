@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdlib.h>
+#include <mutex>
 #include <vector>
 #include <map>
 
@@ -38,6 +39,8 @@ namespace sge
 	*
 	*	The allocator uses PagePool style which means that the memory is divided by size.
 	*	Objects of different sizes are on different pages to make it quick and easy to allocate and deallocate memory.
+	*	Allocating and deallocating are thread safe, so a scene loading in the background can create its
+	*	entities and components while the running scene does the same.
 	*/
 	class PagePoolAllocator
 	{
@@ -118,7 +121,10 @@ namespace sge
 		*/
 		PageMap pageMap;
 
-		std::vector<HeaderLocationInfo> headerLocations; /**<  Vector for storing information about the pages. */
+		/**<	Information about the pages keyed by their first slot, so deallocate finds the page of a pointer with a single lookup. */
+		std::map<const void*, HeaderLocationInfo> headerLocations;
+
+		std::mutex mutex; /**<  Guards the pages. */
 	};
 	extern PagePoolAllocator allocator;
 }
\ No newline at end of file
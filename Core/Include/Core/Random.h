@@ -1,8 +1,61 @@
+#pragma once
+
 #include <stdlib.h>
 #include <time.h>
 
+#include "Core/Types.h"
+
 namespace sge
 {
+	/** \brief Deterministic pseudo random number generator.
+	*
+	*	The same seed gives the same sequence on every platform and build, unlike rand().
+	*	Used for everything that must replay exactly, e.g. recorded input sessions.
+	*/
+	class RandomGenerator
+	{
+	public:
+		/** \brief The constructor.
+		*
+		*	\param uint32 seed : The seed number
+		*/
+		explicit RandomGenerator(uint32 seed = 1)
+		{
+			setSeed(seed);
+		}
+
+		/** \brief Restarts the sequence from the given seed. */
+		void setSeed(uint32 seed)
+		{
+			// Splitmix64 spreads small seeds over the whole state, which must not be zero.
+			uint64 z = seed + 0x9e3779b97f4a7c15ull;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+			state = (z ^ (z >> 31)) | 1;
+		}
+
+		/** \brief Generates the next number of the sequence (xorshift64*). */
+		uint32 next()
+		{
+			state ^= state >> 12;
+			state ^= state << 25;
+			state ^= state >> 27;
+			return static_cast<uint32>((state * 0x2545f4914f6cdd1dull) >> 32);
+		}
+
+		/** \brief Generates a number in [0, 1). */
+		double nextUnit()
+		{
+			return next() / 4294967296.0;
+		}
+
+	private:
+		uint64 state;
+	};
+
+	/** \brief The generator used by the random functions below. */
+	RandomGenerator& getRandomGenerator();
+
 	/** \brief Initializes with a random seed.
 	*
 	*	An initialization which uses time(NULL) as seed to generate random number sequence.
@@ -38,6 +91,6 @@ namespace sge
 	template <typename T>
 	T random(const T &min, const T &max)
 	{
-		return min + (T(rand()) / (T)RAND_MAX * (max - min));
+		return min + static_cast<T>(getRandomGenerator().nextUnit() * (max - min));
 	}
 }
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sge
+{
+	/** \brief A fixed set of worker threads that process indexed tasks.
+	*
+	*	Work is handed out in batches of indices. The thread that dispatches a batch works on it as well
+	*	and only returns once every index has been processed, which makes dispatching from inside a task safe.
+	*	A pool without workers runs everything on the calling thread in index order.
+	*/
+	class ThreadPool
+	{
+	public:
+		using Task = std::function<void(size_t)>;
+		using RangeTask = std::function<void(size_t, size_t)>;
+
+		/** \brief The constructor.
+		*
+		*	\param size_t workerCount : Number of threads to start in addition to the calling thread.
+		*/
+		explicit ThreadPool(size_t workerCount);
+
+		/** \brief The destructor. Stops and joins all worker threads. */
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		void operator=(const ThreadPool&) = delete;
+
+		/** \brief Runs task(i) for every i in [0, count) and waits for all of them to finish.
+		*
+		*	\param size_t count : Number of indices to process.
+		*	\param const Task& task : Function called once per index.
+		*/
+		void dispatch(size_t count, const Task& task);
+
+		/** \brief Splits [0, count) into chunks and processes them with dispatch.
+		*
+		*	\param size_t count : Number of elements.
+		*	\param size_t chunkSize : Maximum number of elements handed to a single call.
+		*	\param const RangeTask& task : Function called with the [begin, end) range of each chunk.
+		*/
+		void parallelFor(size_t count, size_t chunkSize, const RangeTask& task);
+
+		size_t getWorkerCount() const
+		{
+			return workers.size();
+		}
+
+		/** \brief Worker count that leaves one hardware thread for the caller. */
+		static size_t getDefaultWorkerCount();
+
+	private:
+		/** \brief Indices of a single dispatch call. Lives on the stack of the dispatching thread. */
+		struct Batch
+		{
+			const Task* task;	/**<  Function to call for each index. */
+			size_t count;		/**<  Total number of indices. */
+			size_t next;		/**<  Next index to hand out. */
+			size_t done;		/**<  Number of indices that have finished. */
+		};
+
+		/** \brief Claims and runs the next index of the batch. The lock must be held and the batch must have indices left. */
+		void runNext(std::unique_lock<std::mutex>& lock, Batch* batch);
+
+		void workerLoop();
+
+		std::vector<std::thread> workers;
+		std::deque<Batch*> batches;		/**<  Batches that still have unclaimed indices. */
+		std::mutex mutex;
+		std::condition_variable workAvailable;
+		std::condition_variable batchDone;
+		bool stopping;
+	};
+}
@@ -0,0 +1,139 @@
+#include "Core/Bounds.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#define SGE_BOUNDS_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace sge
+{
+	static_assert(sizeof(BoundingSphere) == 4 * sizeof(float), "Frustum::cull loads spheres as four floats.");
+
+	AABB AABB::transform(const math::mat4& matrix) const
+	{
+		// Arvo's method: the extents along each world axis are the absolute matrix times the extents.
+		math::vec3 center = math::vec3(matrix * math::vec4((min + max) * 0.5f, 1.0f));
+		math::vec3 extents = (max - min) * 0.5f;
+		math::mat3 absolute = math::mat3(math::abs(math::vec3(matrix[0])), math::abs(math::vec3(matrix[1])), math::abs(math::vec3(matrix[2])));
+
+		math::vec3 worldExtents = absolute * extents;
+
+		AABB box = { center - worldExtents, center + worldExtents };
+		return box;
+	}
+
+	BoundingSphere BoundingSphere::transform(const math::mat4& matrix) const
+	{
+		float scale = math::max(math::length(math::vec3(matrix[0])),
+			math::max(math::length(math::vec3(matrix[1])), math::length(math::vec3(matrix[2]))));
+
+		BoundingSphere sphere = { math::vec3(matrix * math::vec4(center, 1.0f)), radius * scale };
+		return sphere;
+	}
+
+	Frustum::Frustum(const math::mat4& viewProj)
+	{
+		math::mat4 m = math::transpose(viewProj);
+
+		planes[0] = m[3] + m[0];	// Left
+		planes[1] = m[3] - m[0];	// Right
+		planes[2] = m[3] + m[1];	// Bottom
+		planes[3] = m[3] - m[1];	// Top
+		planes[4] = m[3] + m[2];	// Near, also contains the near plane of a 0..1 depth range.
+		planes[5] = m[3] - m[2];	// Far
+
+		for (auto& plane : planes)
+		{
+			plane /= math::length(math::vec3(plane));
+		}
+	}
+
+	bool Frustum::intersects(const AABB& box) const
+	{
+		for (auto& plane : planes)
+		{
+			// The corner furthest along the normal.
+			math::vec3 corner(
+				plane.x >= 0.0f ? box.max.x : box.min.x,
+				plane.y >= 0.0f ? box.max.y : box.min.y,
+				plane.z >= 0.0f ? box.max.z : box.min.z);
+
+			if (math::dot(math::vec3(plane), corner) + plane.w < 0.0f)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool Frustum::intersects(const BoundingSphere& sphere) const
+	{
+		for (auto& plane : planes)
+		{
+			if (math::dot(math::vec3(plane), sphere.center) + plane.w < -sphere.radius)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	size_t Frustum::cull(const BoundingSphere* spheres, size_t count, uint8* visible) const
+	{
+		size_t visibleCount = 0;
+		size_t i = 0;
+
+#ifdef SGE_BOUNDS_SSE
+		__m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+
+		for (size_t p = 0; p < 6; p++)
+		{
+			planeX[p] = _mm_set1_ps(planes[p].x);
+			planeY[p] = _mm_set1_ps(planes[p].y);
+			planeZ[p] = _mm_set1_ps(planes[p].z);
+			planeW[p] = _mm_set1_ps(planes[p].w);
+		}
+
+		for (; i + 4 <= count; i += 4)
+		{
+			// Four spheres transposed to x, y, z and radius registers.
+			const float* data = &spheres[i].center.x;
+			__m128 x = _mm_loadu_ps(data);
+			__m128 y = _mm_loadu_ps(data + 4);
+			__m128 z = _mm_loadu_ps(data + 8);
+			__m128 r = _mm_loadu_ps(data + 12);
+			_MM_TRANSPOSE4_PS(x, y, z, r);
+
+			__m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), r);
+			__m128 outside = _mm_setzero_ps();
+
+			for (size_t p = 0; p < 6; p++)
+			{
+				__m128 distance = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(x, planeX[p]), _mm_mul_ps(y, planeY[p])),
+					_mm_add_ps(_mm_mul_ps(z, planeZ[p]), planeW[p]));
+
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negativeRadius));
+			}
+
+			int mask = _mm_movemask_ps(outside);
+
+			for (size_t j = 0; j < 4; j++)
+			{
+				visible[i + j] = (mask >> j) & 1 ? 0 : 1;
+				visibleCount += visible[i + j];
+			}
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			visible[i] = intersects(spheres[i]) ? 1 : 0;
+			visibleCount += visible[i];
+		}
+
+		return visibleCount;
+	}
+}
@@ -0,0 +1,169 @@
+#include "Core/MappedFile.h"
+
+#include <cstdio>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sge
+{
+	MappedFile::MappedFile() :
+		data(nullptr),
+		size(0),
+		mapped(false)
+#if defined(_WIN32)
+		, fileHandle(INVALID_HANDLE_VALUE),
+		mappingHandle(nullptr)
+#endif
+	{
+	}
+
+	MappedFile::~MappedFile()
+	{
+		close();
+	}
+
+	bool MappedFile::open(const std::string& path)
+	{
+		close();
+
+		// Empty files can't be mapped, read() handles them.
+		return map(path) || read(path);
+	}
+
+	void MappedFile::close()
+	{
+		if (mapped)
+		{
+#if defined(_WIN32)
+			UnmapViewOfFile(data);
+			CloseHandle(mappingHandle);
+			CloseHandle(fileHandle);
+
+			mappingHandle = nullptr;
+			fileHandle = INVALID_HANDLE_VALUE;
+#else
+			munmap(const_cast<void*>(data), size);
+#endif
+		}
+
+		buffer.clear();
+		buffer.shrink_to_fit();
+
+		data = nullptr;
+		size = 0;
+		mapped = false;
+	}
+
+#if defined(_WIN32)
+	bool MappedFile::map(const std::string& path)
+	{
+		fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+		if (fileHandle == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER fileSize;
+
+		if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+		{
+			CloseHandle(fileHandle);
+			fileHandle = INVALID_HANDLE_VALUE;
+			return false;
+		}
+
+		mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		void* view = mappingHandle ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+		if (view == nullptr)
+		{
+			if (mappingHandle)
+			{
+				CloseHandle(mappingHandle);
+				mappingHandle = nullptr;
+			}
+
+			CloseHandle(fileHandle);
+			fileHandle = INVALID_HANDLE_VALUE;
+			return false;
+		}
+
+		data = view;
+		size = static_cast<size_t>(fileSize.QuadPart);
+		mapped = true;
+
+		return true;
+	}
+#else
+	bool MappedFile::map(const std::string& path)
+	{
+		int file = ::open(path.c_str(), O_RDONLY);
+
+		if (file < 0)
+		{
+			return false;
+		}
+
+		struct stat info;
+
+		if (fstat(file, &info) != 0 || info.st_size == 0)
+		{
+			::close(file);
+			return false;
+		}
+
+		void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+		// The mapping stays valid after the descriptor is closed.
+		::close(file);
+
+		if (view == MAP_FAILED)
+		{
+			return false;
+		}
+
+		data = view;
+		size = static_cast<size_t>(info.st_size);
+		mapped = true;
+
+		return true;
+	}
+#endif
+
+	bool MappedFile::read(const std::string& path)
+	{
+		FILE* file = std::fopen(path.c_str(), "rb");
+
+		if (file == nullptr)
+		{
+			return false;
+		}
+
+		std::fseek(file, 0, SEEK_END);
+		long fileSize = std::ftell(file);
+		std::fseek(file, 0, SEEK_SET);
+
+		if (fileSize > 0)
+		{
+			buffer.resize(static_cast<size_t>(fileSize));
+			buffer.resize(std::fread(buffer.data(), 1, buffer.size(), file));
+		}
+
+		std::fclose(file);
+
+		data = buffer.data();
+		size = buffer.size();
+
+		return true;
+	}
+}
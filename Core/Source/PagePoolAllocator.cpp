@@ -16,6 +16,8 @@ namespace sge
 
 	void *PagePoolAllocator::allocate(size_t size)
 	{
+		std::lock_guard<std::mutex> lock(mutex);
+
 		PageMap::iterator p = pageMap.find(size);
 		PageHeader *page = NULL;
 
@@ -67,18 +69,18 @@ namespace sge
 	
 	void PagePoolAllocator::deallocate(void *data)
 	{
+		std::lock_guard<std::mutex> lock(mutex);
+
 		PageHeader *page = NULL;
 
-		// Finds where the pointer is located
-		for (unsigned i = 0; headerLocations.size(); i++)
+		// Finds where the pointer is located, the page starting last at or before it is the only candidate
+		auto location = headerLocations.upper_bound(data);
+		if (location != headerLocations.begin())
 		{
-			if (data >= headerLocations[i].bottom)
+			--location;
+			if (data < location->second.top)
 			{
-				if (data < headerLocations[i].top)
-				{
-					page = headerLocations[i].page;
-					break;
-				}
+				page = location->second.page;
 			}
 		}
 		
@@ -117,12 +119,12 @@ namespace sge
 		page->freeSpaceCount = 0;
 		page->nextPage = NULL;
 
-		// Stores all the needed info from the page to new headerLocationInfo which is then pushed to a vector
+		// Stores all the needed info from the page to new headerLocationInfo which is then added to the page index
 		HeaderLocationInfo headerLocationInfo;
 		headerLocationInfo.page = page;
 		headerLocationInfo.bottom = page + 1;
 		headerLocationInfo.top = (char*)headerLocationInfo.bottom + page->slotCount * page->slotSize;
-		headerLocations.push_back(headerLocationInfo);
+		headerLocations.insert(std::make_pair(headerLocationInfo.bottom, headerLocationInfo));
 
 		return page;
 	}
@@ -2,22 +2,28 @@
 
 namespace sge
 {
+	RandomGenerator& getRandomGenerator()
+	{
+		static RandomGenerator generator;
+		return generator;
+	}
+
 	void randomSeed()
 	{
-		srand(time(NULL));
+		getRandomGenerator().setSeed(static_cast<uint32>(time(NULL)));
 	}
 
 	void setSeed(const unsigned int &seed)
 	{
-		srand(seed);
+		getRandomGenerator().setSeed(seed);
 	}
 
 	int random(const int &min, const int &max)
 	{
 		if (min < max)
 		{
-			return min + rand() % (max - min + 1);
+			return min + static_cast<int>(getRandomGenerator().next() % static_cast<uint32>(max - min + 1));
 		}
-		return max + rand() % (min - max + 1);
+		return max + static_cast<int>(getRandomGenerator().next() % static_cast<uint32>(min - max + 1));
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,122 @@
+#include "Core/ThreadPool.h"
+
+#include <algorithm>
+
+namespace sge
+{
+	ThreadPool::ThreadPool(size_t workerCount) : stopping(false)
+	{
+		for (size_t i = 0; i < workerCount; i++)
+		{
+			workers.emplace_back(&ThreadPool::workerLoop, this);
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+
+		workAvailable.notify_all();
+
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	size_t ThreadPool::getDefaultWorkerCount()
+	{
+		unsigned int hardwareThreads = std::thread::hardware_concurrency();
+
+		return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	void ThreadPool::dispatch(size_t count, const Task& task)
+	{
+		// Nothing to share, keep it on this thread.
+		if (workers.empty() || count <= 1)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				task(i);
+			}
+			return;
+		}
+
+		Batch batch = { &task, count, 0, 0 };
+
+		std::unique_lock<std::mutex> lock(mutex);
+
+		batches.push_back(&batch);
+		workAvailable.notify_all();
+
+		// Help with our own batch instead of idling.
+		while (batch.next < batch.count)
+		{
+			runNext(lock, &batch);
+		}
+
+		batchDone.wait(lock, [&batch]() { return batch.done == batch.count; });
+	}
+
+	void ThreadPool::parallelFor(size_t count, size_t chunkSize, const RangeTask& task)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		if (chunkSize == 0)
+		{
+			chunkSize = 1;
+		}
+
+		size_t chunks = (count + chunkSize - 1) / chunkSize;
+
+		dispatch(chunks, [&](size_t chunk)
+		{
+			size_t begin = chunk * chunkSize;
+			task(begin, std::min(begin + chunkSize, count));
+		});
+	}
+
+	void ThreadPool::runNext(std::unique_lock<std::mutex>& lock, Batch* batch)
+	{
+		size_t index = batch->next++;
+
+		// Last index handed out, nobody else needs to see this batch.
+		if (batch->next == batch->count)
+		{
+			batches.erase(std::find(batches.begin(), batches.end(), batch));
+		}
+
+		lock.unlock();
+		(*batch->task)(index);
+		lock.lock();
+
+		if (++batch->done == batch->count)
+		{
+			batchDone.notify_all();
+		}
+	}
+
+	void ThreadPool::workerLoop()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		while (true)
+		{
+			workAvailable.wait(lock, [this]() { return stopping || !batches.empty(); });
+
+			if (stopping)
+			{
+				return;
+			}
+
+			runNext(lock, batches.front());
+		}
+	}
+}
@@ -3,10 +3,12 @@
 #include "Renderer/Viewport.h"
 #include "Game/Component.h"
 #include "Core/Math.h"
+#include "Core/Types.h"
 
 namespace sge
 {
 	class TransformComponent;
+	struct RenderTarget;
 
 	class CameraComponent : public Component
 	{
@@ -14,6 +16,7 @@ namespace sge
 		CameraComponent(Entity* ent);
 
         // TODO we can't have a general setup method because we need to support both ortho and perspective projections.
+		/** \brief Recomputes the view projection matrix if the projection or the transform has changed. */
 		void update();
 
         void setPerspective(float fov, float aspectRatio, float near, float far);
@@ -32,6 +35,31 @@ namespace sge
             return viewProj;
         }
 
+        /** \brief Sets the target the camera draws into, it is cleared before the camera's first draw.
+        *
+        * Null draws into the target bound with RenderSystem::setRenderTarget, which isn't cleared.
+        */
+        void setRenderTarget(RenderTarget* renderTarget)
+        {
+            this->renderTarget = renderTarget;
+        }
+
+        RenderTarget* getRenderTarget() const
+        {
+            return renderTarget;
+        }
+
+        /** \brief Layers the camera draws, bit n for RenderComponent layer n. All layers by default. */
+        void setLayerMask(uint32 layerMask)
+        {
+            this->layerMask = layerMask;
+        }
+
+        uint32 getLayerMask() const
+        {
+            return layerMask;
+        }
+
 	private:
         void updateView();
 
@@ -41,5 +69,10 @@ namespace sge
 		math::mat4 proj;
 
         TransformComponent* transform;
+        RenderTarget* renderTarget;
+        uint32 layerMask;
+
+        unsigned int viewVersion; /**< Change version the view was last computed at. */
+        bool projChanged;
 	};
 }
\ No newline at end of file
@@ -36,8 +36,36 @@ namespace sge
             return parent->getComponent<T>();
         }
 
+		/** \brief Change version of the Component.
+		*
+		* Mutators stamp the Component with the current global version. Compare against a
+		* version taken with nextChangeVersion() to see whether it changed since then.
+		* \return Version of the last change.
+		*/
+		unsigned int getChangeVersion() const
+		{
+			return changeVersion;
+		}
+
+		bool hasChangedSince(unsigned int version) const
+		{
+			return changeVersion > version;
+		}
+
+		/** \brief Stamps the Component as changed. */
+		void markChanged();
+
+		/** \brief Advances the global version.
+		*
+		* Store the returned version and pass it to hasChangedSince() later, every change made
+		* after this call compares as newer.
+		* \return The version before advancing.
+		*/
+		static unsigned int nextChangeVersion();
+
 	private:
 		bool alive;
 		Entity* parent; /**< Pointer to the parent Entity. */
+		unsigned int changeVersion;
 	};
 }
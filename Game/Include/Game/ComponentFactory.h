@@ -1,4 +1,7 @@
 #pragma once
+#include <algorithm>
+#include <iterator>
+#include <new>
 #include <vector>
 #include "Game/Entity.h"
 #include "Core/Memory/PagePoolAllocator.h"
@@ -14,7 +17,7 @@ namespace sge
 		{
 			for (auto component : components)
 			{
-				allocator.destroy<T>(component);
+				destroy(component);
 			}
 			components.clear();
 		};
@@ -34,20 +37,87 @@ namespace sge
 			return component;
 		}
 
+		/** \brief Creates a component for each of the entities in one contiguous block.
+		*
+		* The components are constructed in place, one after another, and added to the
+		* entities and the factory's container in order. They can be removed one by one like
+		* any other component, the block is freed with the last one.
+		* \param Entity* const* entities : Owners of the new components.
+		* \param size_t count : Number of entities.
+		* \return Pointer to the first component, the rest follow it. Nullptr if count is zero.
+		*/
+		T* createBulk(Entity* const* entities, size_t count)
+		{
+			if (count == 0)
+			{
+				return nullptr;
+			}
+
+			T* first = static_cast<T*>(::operator new(sizeof(T) * count));
+			Block block = { first, first + count, count };
+			blocks.push_back(block);
+
+			for (size_t i = 0; i < count; i++)
+			{
+				T* component = new (first + i) T(entities[i]);
+				entities[i]->setComponent(component);
+				components.push_back(component);
+			}
+
+			return first;
+		}
+
 		/** \brief Removes a component.
 		*
-		* Removes a component of type T.
+		* Detaches a component of type T from its Entity and destroys it.
 		* \param T* component : Pointer to a type of Component
 		*/
 		void remove(T* component)
 		{
-			allocator.destroy<T>(component);
-			components.erase(std::remove(components.begin(), components.end(), component), components.end());
+			component->getParent()->detachComponent(component);
+			destroy(component);
+
+			// Searching from the back makes removing the newest components cheap.
+			auto it = std::find(components.rbegin(), components.rend(), component);
+
+			if (it != components.rend())
+			{
+				components.erase(std::next(it).base());
+			}
 		}
 
         const std::vector<T*>& getComponents() { return components; }
 
 	private:
+		/** \brief Components created by one createBulk call. */
+		struct Block
+		{
+			T* begin;
+			T* end;
+			size_t live; /**< Components of the block not yet destroyed. */
+		};
+
+		void destroy(T* component)
+		{
+			for (auto it = blocks.begin(); it != blocks.end(); ++it)
+			{
+				if (component >= it->begin && component < it->end)
+				{
+					component->~T();
+
+					if (--it->live == 0)
+					{
+						::operator delete(it->begin);
+						blocks.erase(it);
+					}
+					return;
+				}
+			}
+
+			allocator.destroy<T>(component);
+		}
+
 		std::vector<T*> components; /**< Vector of Component pointers */
+		std::vector<Block> blocks;
 	};
 }
\ No newline at end of file
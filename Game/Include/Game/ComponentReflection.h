@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "Core/Types.h"
+
+namespace sge
+{
+	/** \brief Location of a plain data member inside a Component. */
+	struct ReflectedField
+	{
+		const char* name;
+		uint32 nameHash;
+		uint32 offset; /**< Byte offset from the start of the Component. */
+		uint32 size;
+	};
+
+	/** \brief Describes the plain data members of a Component type.
+	*
+	* Reflected members are copied byte for byte when a scene is saved or loaded, so only
+	* trivially copyable members may be reflected. Pointers and containers are left out,
+	* the constructor sets them up.
+	*
+	* Components expose their description through a static getReflection() function:
+	*
+	* const ComponentReflection& MyComponent::getReflection()
+	* {
+	*     static const ComponentReflection reflection = ComponentReflection("MyComponent")
+	*         .field("speed", &MyComponent::speed);
+	*     return reflection;
+	* }
+	*/
+	class ComponentReflection
+	{
+	public:
+		/** \brief Constructor.
+		*
+		* \param const char* name : Name of the type. Identifies the type in saved files, so don't change it.
+		*/
+		explicit ComponentReflection(const char* name) : name(name), typeId(hash(name)), dataSize(0)
+		{
+		}
+
+		/** \brief Adds a member to the description.
+		*
+		* \param const char* name : Name of the member. Identifies the member in saved files.
+		* \param M T::* member : Pointer to the member.
+		* \return The description, so calls can be chained.
+		*/
+		template <typename T, typename M>
+		ComponentReflection& field(const char* name, M T::* member)
+		{
+			static_assert(std::is_trivially_copyable<M>::value, "Only trivially copyable members can be reflected.");
+
+			// Measures the offset on uninitialized storage, offsetof doesn't work on classes with virtual functions.
+			typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+			const T* object = reinterpret_cast<const T*>(&storage);
+			size_t offset = reinterpret_cast<const char*>(&(object->*member)) - reinterpret_cast<const char*>(object);
+
+			ReflectedField reflected = { name, hash(name), static_cast<uint32>(offset), static_cast<uint32>(sizeof(M)) };
+			fields.push_back(reflected);
+			dataSize += reflected.size;
+
+			return *this;
+		}
+
+		const char* getName() const
+		{
+			return name;
+		}
+
+		/** \brief Stable identifier of the type, the hash of its name. */
+		uint32 getTypeId() const
+		{
+			return typeId;
+		}
+
+		const std::vector<ReflectedField>& getFields() const
+		{
+			return fields;
+		}
+
+		/** \brief Combined size of all reflected members. */
+		uint32 getDataSize() const
+		{
+			return dataSize;
+		}
+
+		/** \brief FNV-1a hash used for type and member names. Stays the same between runs and builds. */
+		static uint32 hash(const char* string)
+		{
+			uint32 result = 2166136261u;
+
+			for (; *string; string++)
+			{
+				result = (result ^ static_cast<uint8>(*string)) * 16777619u;
+			}
+
+			return result;
+		}
+
+	private:
+		const char* name;
+		uint32 typeId;
+		uint32 dataSize;
+		std::vector<ReflectedField> fields;
+	};
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Game/LightComponent.h"
+#include "Game/ComponentReflection.h"
 
 namespace sge
 {
@@ -21,7 +22,10 @@ namespace sge
         void update();
 
         const DirLight& getLightData() { return lightData; }
-        void setLightData(const DirLight& data) { lightData = data; }
+        void setLightData(const DirLight& data) { lightData = data; markChanged(); }
+
+        /** \brief Members saved in scene snapshots. */
+        static const ComponentReflection& getReflection();
     private:
         DirLight lightData;
     };
@@ -4,13 +4,17 @@
 #include <string>
 #include <algorithm>
 
+#include "Core/Types.h"
+
 namespace sge
 {
 	class Component;
+	class EntityManager;
+
 	class Entity
 	{
 	public:
-        Entity() : tag("generic")
+        Entity() : tag("generic"), manager(nullptr), tagId(0), tagSlot(0)
 		{
          
 		}
@@ -40,19 +44,26 @@ namespace sge
 		
 		/** \brief Component Removal function.
 		*
-		* Removes Component T from the Entity's Component vector by performing satanic rituals.
+		* Removes every Component of type T from the Entity's Component vector.
+		* Only detaches the Components, destroying them is up to their ComponentFactory.
 		*/
 		template<class T>
 		void removeComponent() 
 		{
 			components.erase(std::remove_if(components.begin(), components.end(),
-				[&](Component* component) 
+				[](Component* component) 
 				{
-					return getComponent<T>();
+					return dynamic_cast<T*>(component) != nullptr;
 				}),
 				components.end());
 		}
-		
+
+		/** \brief Detaches a single Component from the Entity.
+		*
+		* \param Component* comp : Component to detach.
+		*/
+		void detachComponent(Component* comp);
+
 		/** \brief Setter function for Components.
 		*
 		* Pushes a new Component to the back of the Component vector.
@@ -60,19 +71,32 @@ namespace sge
 		*/
 		void setComponent(Component* comp); 
 
-        void setTag(const std::string& tag)
-        {
-            this->tag = tag;
-        }
+        /** \brief Sets the tag of the Entity.
+        *
+        * Also updates the tag index of the EntityManager that created the Entity.
+        * \param const std::string& tag : New tag.
+        */
+        void setTag(const std::string& tag);
 
         const std::string& getTag()
         {
             return tag;
         }
 
+        /** \brief Interned tag ID, valid in the EntityManager that created the Entity. */
+        uint32 getTagId() const
+        {
+            return tagId;
+        }
+
 	private:
+        friend class EntityManager;
+
         std::string tag;
 		std::vector<Component*> components; /**< Vector of Component pointers */
+
+        EntityManager* manager; /**< Manager that created the Entity, or nullptr. */
+        uint32 tagId;
+        size_t tagSlot; /**< Position in the manager's list of entities with the same tag. */
 	};
 }
-
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "Game/ComponentFactory.h"
+#include "Game/Entity.h"
+
+namespace sge
+{
+	class Component;
+	class EntityManager;
+	class SystemManager;
+
+	/** \brief Records structural changes to entities for later playback.
+	*
+	* Creating and destroying entities or adding and removing components while a System
+	* iterates its components is unsafe. Record the change here instead and play the buffer
+	* back once the iteration is done. Recording is thread safe, so worker threads may share a buffer.
+	*
+	* Playback runs all creates first, then adds, removes and finally destroys, each group in recording order.
+	* Remove the components of an entity before destroying it, the buffer can't know their factories.
+	*/
+	class EntityCommandBuffer
+	{
+	public:
+		/** \brief Entity that will be created on playback. Can be used as a target before that. */
+		struct PendingEntity
+		{
+			size_t index;
+		};
+
+		EntityCommandBuffer();
+
+		EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+		void operator=(const EntityCommandBuffer&) = delete;
+
+		/** \brief Records the creation of an Entity.
+		*
+		* \return Handle to the Entity, valid as a target for this buffer only.
+		*/
+		PendingEntity createEntity();
+
+		/** \brief Records the destruction of an Entity. */
+		void destroyEntity(Entity* entity);
+
+		/** \brief Records the creation of a Component through its factory.
+		*
+		* \param ComponentFactory<T>& factory : Factory that creates and owns the Component.
+		* \param Entity* entity : Owner of the new Component.
+		* \param const std::function<void(T*)>& init : Optional function that sets the initial values.
+		*/
+		template <typename T>
+		void addComponent(ComponentFactory<T>& factory, Entity* entity, const std::function<void(T*)>& init = nullptr)
+		{
+			record(ADD, entity, 0, &factory, &createComponent<T>, wrap(init));
+		}
+
+		template <typename T>
+		void addComponent(ComponentFactory<T>& factory, PendingEntity entity, const std::function<void(T*)>& init = nullptr)
+		{
+			record(ADD, nullptr, entity.index, &factory, &createComponent<T>, wrap(init));
+		}
+
+		/** \brief Records the removal of a Component through the factory that created it. */
+		template <typename T>
+		void removeComponent(ComponentFactory<T>& factory, T* component)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			Command command = { REMOVE, component->getParent(), 0, component, &factory, nullptr, &destroyComponent<T>, NO_INIT };
+			commands.push_back(command);
+		}
+
+		/** \brief Applies and clears all recorded commands.
+		*
+		* Must not run while systems are updating.
+		* \param EntityManager& entityManager : Manager that creates and destroys the entities.
+		* \param SystemManager* systemManager : Systems that new and removed components are registered to, or nullptr.
+		*/
+		void playback(EntityManager& entityManager, SystemManager* systemManager);
+
+		bool isEmpty()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			return commands.empty();
+		}
+
+		void clear();
+
+	private:
+		enum CommandType
+		{
+			CREATE,
+			ADD,
+			REMOVE,
+			DESTROY
+		};
+
+		using CreateFunction = Component* (*)(void* factory, Entity* entity);
+		using DestroyFunction = void(*)(void* factory, Component* component);
+		using InitFunction = std::function<void(Component*)>;
+
+		static const size_t NO_INIT = static_cast<size_t>(-1);
+
+		/** \brief Plain data of a single command. Typed work goes through the function pointers. */
+		struct Command
+		{
+			CommandType type;
+			Entity* entity;			/**< Target, or nullptr for a pending entity. */
+			size_t pending;			/**< Index of the pending target when entity is nullptr. */
+			Component* component;	/**< Component to remove. */
+			void* factory;
+			CreateFunction create;
+			DestroyFunction destroy;
+			size_t init;			/**< Index into inits or NO_INIT. */
+		};
+
+		template <typename T>
+		static Component* createComponent(void* factory, Entity* entity)
+		{
+			return static_cast<ComponentFactory<T>*>(factory)->create(entity);
+		}
+
+		template <typename T>
+		static void destroyComponent(void* factory, Component* component)
+		{
+			static_cast<ComponentFactory<T>*>(factory)->remove(static_cast<T*>(component));
+		}
+
+		template <typename T>
+		static InitFunction wrap(const std::function<void(T*)>& init)
+		{
+			if (!init)
+			{
+				return nullptr;
+			}
+
+			return [init](Component* component) { init(static_cast<T*>(component)); };
+		}
+
+		void record(CommandType type, Entity* entity, size_t pending, void* factory, CreateFunction create, InitFunction init);
+
+		std::vector<Command> commands;
+		std::vector<InitFunction> inits;
+		std::vector<Entity*> created; /**< Entities created during playback, indexed by PendingEntity. */
+		size_t pendingCount;
+		std::mutex mutex;
+	};
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Game/Entity.h"
@@ -11,6 +13,8 @@ namespace sge
 	class EntityManager
 	{
 	public:
+		EntityManager();
+
 		/** \brief Creates a transformable Entity.
 		*
 		* Creates an empty Entity and adds it to the manager's container.
@@ -18,11 +22,59 @@ namespace sge
 		*/
 		Entity* createEntity();
 
+		/** \brief Creates several transformable Entities at once.
+		*
+		* \param size_t count : Number of entities to create.
+		* \param std::vector<Entity*>& out : The new entities are appended here.
+		*/
+		void createEntities(size_t count, std::vector<Entity*>& out);
+
+		/** \brief Destroys an Entity.
+		*
+		* Removes the Entity from the manager's container and frees it.
+		* Its Components must be removed through their factories first.
+		* \param Entity* entity : Entity to destroy.
+		*/
+		void destroyEntity(Entity* entity);
+
 		std::vector<Entity*>& getEntities()
 		{
 			return entities;
 		}
+
+		/** \brief Interns a tag.
+		*
+		* \param const std::string& tag : Tag to intern.
+		* \return ID of the tag, the same for every call with the same tag.
+		*/
+		uint32 getTagId(const std::string& tag);
+
+		/** \brief Getter function for the entities with a tag.
+		*
+		* Uses the tag index, so the cost doesn't depend on the total number of entities.
+		* The order of the entities is unspecified.
+		* \param uint32 tagId : Interned tag, see getTagId.
+		* \return Entities with the tag.
+		*/
+		const std::vector<Entity*>& getEntitiesWithTag(uint32 tagId) const;
+
+		/** \brief Getter function for the entities with a tag. Doesn't intern the tag. */
+		const std::vector<Entity*>& getEntitiesWithTag(const std::string& tag) const;
+
+		/** \brief Returns an Entity with the tag, or nullptr if there are none. */
+		Entity* findEntityWithTag(const std::string& tag) const;
+
 	private:
+		friend class Entity;
+
+		/** \brief Moves the Entity to the index entry of its current tag. Called by Entity::setTag. */
+		void updateTag(Entity* entity);
+
+		void removeFromTagIndex(Entity* entity);
+
 		std::vector<Entity*> entities; /**< Vector of Entity pointers. */
+
+		std::unordered_map<std::string, uint32> tagIds; /**< Interned tags. */
+		std::vector<std::vector<Entity*>> tagged; /**< Entities of each tag, indexed by tag ID. */
 	};
 }
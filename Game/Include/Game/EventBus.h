@@ -0,0 +1,153 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "Core/Assert.h"
+
+namespace sge
+{
+	/** \brief Typed event queues for communication between systems.
+	*
+	* Every event type has its own contiguous queue. Events published during a frame become
+	* readable after the next dispatch() and stay readable until the one after it, so each
+	* subscriber sees the whole batch of the previous frame no matter in which order the
+	* systems are updated. Publishing is thread safe, reading is safe while nobody dispatches.
+	*
+	* struct DespawnRequest { Entity* entity; };
+	*
+	* events->publish(DespawnRequest{ entity });			// In one system.
+	* for (auto& request : events->getEvents<DespawnRequest>())	// In another, a frame later.
+	*
+	* Events are copied byte for byte, so they must be trivially copyable.
+	*
+	* Each queue has its own lock. Finding the queue of a type doesn't lock once the queue exists,
+	* so publishers of different types never wait on each other.
+	*/
+	class EventBus
+	{
+	public:
+		EventBus()
+		{
+			for (auto& queue : queues)
+			{
+				queue.store(nullptr, std::memory_order_relaxed);
+			}
+		}
+
+		EventBus(const EventBus&) = delete;
+		void operator=(const EventBus&) = delete;
+
+		/** \brief Appends an event to the queue of its type. */
+		template <typename E>
+		void publish(const E& event)
+		{
+			Queue<E>& queue = getQueue<E>();
+
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.pending.push_back(event);
+		}
+
+		/** \brief Appends a batch of events with a single lock. */
+		template <typename E>
+		void publish(const E* events, size_t count)
+		{
+			Queue<E>& queue = getQueue<E>();
+
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.pending.insert(queue.pending.end(), events, events + count);
+		}
+
+		/** \brief Getter function for the events of type E published before the last dispatch. */
+		template <typename E>
+		const std::vector<E>& getEvents()
+		{
+			return getQueue<E>().current;
+		}
+
+		/** \brief Makes the events published since the last call readable and drops the previous batch.
+		*
+		* Call once per frame while no system is running. Queues keep their memory between frames.
+		*/
+		void dispatch();
+
+	private:
+		struct QueueBase
+		{
+			virtual ~QueueBase() {};
+			virtual void swap() = 0;
+
+			std::mutex mutex;
+		};
+
+		template <typename E>
+		struct Queue : public QueueBase
+		{
+			static_assert(std::is_trivially_copyable<E>::value, "Events must be trivially copyable.");
+
+			void swap()
+			{
+				current.swap(pending);
+				pending.clear();
+			}
+
+			std::vector<E> current; /**< Readable batch. */
+			std::vector<E> pending; /**< Events published since the last dispatch. */
+		};
+
+		/** \brief Index of the event type, the same for every EventBus. */
+		template <typename E>
+		static size_t getTypeIndex()
+		{
+			static const size_t index = nextTypeIndex();
+			return index;
+		}
+
+		static size_t nextTypeIndex();
+
+		template <typename E>
+		Queue<E>& getQueue()
+		{
+			size_t index = getTypeIndex<E>();
+
+			SGE_ASSERT(index < MAX_EVENT_TYPES);
+
+			QueueBase* queue = queues[index].load(std::memory_order_acquire);
+
+			if (queue == nullptr)
+			{
+				queue = createQueue<E>(index);
+			}
+
+			return *static_cast<Queue<E>*>(queue);
+		}
+
+		/** \brief Creates the queue of a type unless another thread got there first. */
+		template <typename E>
+		QueueBase* createQueue(size_t index)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			QueueBase* queue = queues[index].load(std::memory_order_relaxed);
+
+			if (queue == nullptr)
+			{
+				queue = new Queue<E>();
+				owned.emplace_back(queue);
+				queues[index].store(queue, std::memory_order_release);
+			}
+
+			return queue;
+		}
+
+		static const size_t MAX_EVENT_TYPES = 256;
+
+		std::atomic<QueueBase*> queues[MAX_EVENT_TYPES];	/**< Queues indexed by event type. */
+		std::vector<std::unique_ptr<QueueBase>> owned;		/**< The queues in creation order. */
+		std::mutex mutex;									/**< Guards queue creation. */
+	};
+}
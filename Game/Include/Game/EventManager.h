@@ -3,6 +3,9 @@
 #include "HID/KeyboardInput.h"
 #include "HID/MouseInput.h"
 #include "HID/GamepadInput.h"
+#include "Game/InputRecording.h"
+
+#include <vector>
 
 
 // Manager for handling HID
@@ -18,13 +21,69 @@ namespace sge
 
 			bool userQuit();
 
+			/** \brief Applies the input that belongs to the next fixed step.
+			*
+			* update() only queues the events with their timestamps. Each step takes the events
+			* received before its end time, so when a frame runs several steps each of them sees
+			* its own part of the input. A step stops at the second press or release of the same
+			* key or button, the rest waits for the next step so no edge is lost. The last step of
+			* a frame also takes the events received after its end time.
+			* While replaying, the recorded events of the step are applied instead.
+			* \param float endTime : Time the step catches up to, in seconds of SDL_GetTicks.
+			* \param bool lastStep : True for the last step of the frame.
+			*/
+			void beginStep(float endTime, bool lastStep);
+
+			/** \brief Number of fixed steps begun so far. */
+			uint32 getStepCount() const
+			{
+				return stepCount;
+			}
+
+			/** \brief Records every processed event, nullptr to stop recording. */
+			void setRecorder(InputRecorder* recorder)
+			{
+				this->recorder = recorder;
+			}
+
+			/** \brief Replaces the live input with a recorded log, nullptr to go back to live input.
+			*
+			* Only quitting from the window still works while replaying.
+			*/
+			void setReplay(InputReplay* replay)
+			{
+				this->replay = replay;
+			}
+
 		private:
 			void processInput();
+
+			/** \brief Converts an SDL event, returns false for events that aren't input. */
+			bool translate(const SDL_Event& sdlEvent, InputEvent& event);
+
+			void apply(const InputEvent& event);
+
+			/** \brief True if the event is a second edge of a key or button already changed in this step. */
+			bool isRepeatedEdge(const InputEvent& event);
+
+			struct QueuedEvent
+			{
+				InputEvent event;
+				float time;		/**< Time the event was received, in seconds. */
+			};
+
 			bool quitState;
 
 			sge::KeyboardInput* keyboardInput;
 			sge::MouseInput* mouseInput;
 			sge::GamepadInput* gamepadInput;
+
+			std::vector<QueuedEvent> queue;		/**< Events not yet given to a step. */
+			std::vector<InputEvent> stepEdges;	/**< Presses and releases applied in the current step. */
+
+			uint32 stepCount;
+			InputRecorder* recorder;
+			InputReplay* replay;
 			
 	};
-}
\ No newline at end of file
+}
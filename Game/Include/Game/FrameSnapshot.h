@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Core/Math.h"
+#include "Core/Types.h"
+#include "Renderer/Viewport.h"
+
+#include "Game/DirLightComponent.h"
+#include "Game/PointLightComponent.h"
+
+namespace sge
+{
+	class Entity;
+	class CameraComponent;
+	class ModelResource;
+	struct CubeMap;
+	struct Font;
+	struct Pipeline;
+	struct RenderTarget;
+	struct Texture;
+
+	/** \brief Drawable state of one frame, copied out of the components.
+	*
+	* The entries hold only values and GPU objects, no components, so a snapshot can be drawn
+	* while the simulation keeps changing the components it was taken from. Spade keeps two of
+	* them: a scene fills one in Scene::snapshot while the renderer reads the other, see
+	* RenderSystem::begin(const FrameSnapshot&).
+	*
+	* Taking a snapshot updates the lazy matrices of the transforms, so it must be done on the
+	* thread that owns the components.
+	*/
+	class FrameSnapshot
+	{
+	public:
+		struct Camera
+		{
+			Viewport viewport;
+			math::mat4 viewProj;
+			math::vec3 position;
+			math::vec3 front;
+			RenderTarget* renderTarget;		/**< Null for the target bound with RenderSystem::setRenderTarget. */
+			uint32 layerMask;
+		};
+
+		struct Sprite
+		{
+			math::mat4 matrix;
+			math::vec3 position;
+			math::vec4 color;
+			Texture* texture;
+			Pipeline* pipeline;		/**< Null for the default sprite pipeline. */
+			uint32 layer;
+			bool frustumCulling;
+		};
+
+		struct Text
+		{
+			math::mat4 matrix;
+			math::vec3 position;
+			math::vec3 scale;
+			math::vec4 color;
+			Font* font;
+			uint32 layer;
+			uint32 textOffset;		/**< Into getTextData(). */
+			uint32 textLength;
+		};
+
+		struct Model
+		{
+			math::mat4 matrix;
+			math::vec3 position;
+			ModelResource* modelResource;
+			Pipeline* pipeline;
+			CubeMap* cubeMap;
+			float shininess;
+			float glossyness;
+			uint32 layer;
+			bool frustumCulling;
+		};
+
+		/** \brief Empties the snapshot, the memory is kept for the next frame. */
+		void clear();
+
+		void addCamera(CameraComponent* camera);
+		void addCameras(size_t count, Entity* cameras[]);
+		void addSprites(size_t count, Entity* sprites[]);
+		void addTexts(size_t count, Entity* texts[]);
+		void addModels(size_t count, Entity* models[]);
+
+		/** \brief Copies the data of the directional and point lights of the entities, other entities are skipped. */
+		void addLights(size_t count, Entity* lights[]);
+
+		const std::vector<Camera>& getCameras() const { return cameras; }
+		const std::vector<Sprite>& getSprites() const { return sprites; }
+		const std::vector<Text>& getTexts() const { return texts; }
+		const std::vector<Model>& getModels() const { return models; }
+		const std::vector<DirLight>& getDirLights() const { return dirLights; }
+		const std::vector<PointLight>& getPointLights() const { return pointLights; }
+		const std::vector<char>& getTextData() const { return textData; }
+
+	private:
+		std::vector<Camera> cameras;
+		std::vector<Sprite> sprites;
+		std::vector<Text> texts;
+		std::vector<Model> models;
+		std::vector<DirLight> dirLights;
+		std::vector<PointLight> pointLights;
+		std::vector<char> textData;		/**< Strings of the texts back to back. */
+	};
+}
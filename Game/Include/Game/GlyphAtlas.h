@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/Math.h"
+#include "Core/Types.h"
+
+namespace sge
+{
+	class GraphicsDevice;
+	struct Font;
+	struct Texture;
+
+	/** \brief Caches the rendered glyphs of one font at one size in a few large textures.
+	*
+	* Glyphs are rendered with FreeType the first time they are asked for and packed into rows
+	* of the atlas pages. When a glyph doesn't fit, the page that was used least recently is
+	* cleared and reused. Pages used by the string being laid out are never evicted.
+	*/
+	class GlyphAtlas
+	{
+	public:
+		struct Glyph
+		{
+			size_t page;				/**< Index of the page texture. */
+			math::vec2 size;			/**< Bitmap size in pixels. */
+			math::vec2 uvMin;
+			math::vec2 uvMax;
+			math::vec2 horiBearing;		/**< FreeType metrics in 26.6 fixed point. */
+			math::vec2 vertBearing;
+			math::vec2 metrics;
+			math::vec2 advance;			/**< Advance in half pixels, the glyph quads span two units per pixel. */
+		};
+
+		/** \brief The constructor.
+		*
+		* \param GraphicsDevice* device : Device the page textures are created with.
+		* \param Font* font : Font rendered at the size currently set on its face.
+		* \param size_t pageSize : Width and height of a page in pixels.
+		* \param size_t maxPages : Number of pages kept before the least recently used one is reused.
+		*/
+		GlyphAtlas(GraphicsDevice* device, Font* font, size_t pageSize = 512, size_t maxPages = 4);
+		~GlyphAtlas();
+
+		GlyphAtlas(const GlyphAtlas&) = delete;
+		void operator=(const GlyphAtlas&) = delete;
+
+		/** \brief Starts laying out a new string. Pages it uses stay until the next call. */
+		void beginString();
+
+		/** \brief Updates the mipmaps of the pages that changed while laying out the string.
+		*
+		* Call once the glyphs of the string are known and before it's drawn.
+		*/
+		void endString();
+
+		/** \brief Returns the glyph of the character, rendering and packing it if needed.
+		*
+		* \return Nullptr if the glyph is larger than a page.
+		*/
+		const Glyph* getGlyph(uint32 charCode);
+
+		Texture* getPageTexture(size_t page) const
+		{
+			return pages[page].texture;
+		}
+
+		size_t getPageCount() const
+		{
+			return pages.size();
+		}
+
+	private:
+		/** \brief Row of glyphs as tall as its tallest glyph. */
+		struct Shelf
+		{
+			size_t y;
+			size_t height;
+			size_t x;		/**< Start of the free space. */
+		};
+
+		struct Page
+		{
+			Texture* texture;
+			std::vector<Shelf> shelves;
+			size_t bottom;		/**< Start of the space below the shelves. */
+			uint32 lastUsed;	/**< String stamp of the last use. */
+			bool dirty;			/**< Changed since the mipmaps were generated. */
+		};
+
+		bool allocate(Page& page, size_t width, size_t height, size_t& x, size_t& y);
+
+		/** \brief Clears the least recently used page that isn't used by the current string, texture included.
+		*
+		* \return Index of the page, or the page count if every page is in use.
+		*/
+		size_t evict();
+
+		GraphicsDevice* device;
+		Font* font;
+		size_t pageSize;
+		size_t maxPages;
+		std::vector<Page> pages;
+		std::unordered_map<uint32, Glyph> glyphs;
+		std::vector<unsigned char> pixels;	/**< Glyph bitmaps repacked without row padding. */
+		uint32 stringStamp;
+	};
+}
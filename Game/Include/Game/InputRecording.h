@@ -0,0 +1,117 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Core/Types.h"
+
+namespace sge
+{
+	/** \brief One processed input event in a compact, SDL independent form. */
+	struct InputEvent
+	{
+		/** Presses and releases come in pairs, the press first at an even value. */
+		enum Type : uint16
+		{
+			KEY_DOWN,
+			KEY_UP,
+			MOUSE_BUTTON_DOWN,
+			MOUSE_BUTTON_UP,
+			MOUSE_MOTION,
+			MOUSE_WHEEL,
+			GAMEPAD_BUTTON_DOWN,
+			GAMEPAD_BUTTON_UP,
+			GAMEPAD_AXIS,
+			GAMEPAD_ADDED,
+			GAMEPAD_REMOVED,
+			QUIT
+		};
+
+		uint32 step;	/**< Index of the fixed step the event was processed before. */
+		uint16 type;
+		uint16 code;	/**< Scancode, button or axis. */
+		int32 x;		/**< Mouse x, wheel, axis value or gamepad. */
+		int32 y;		/**< Mouse y or gamepad. */
+	};
+
+	/** \brief Collects the input events processed by EventManager.
+	*
+	* The log starts with the seed given to start(), which is also set as the seed of
+	* sge::random, so a replay of the log gets the same random numbers as the session.
+	*/
+	class InputRecorder
+	{
+	public:
+		InputRecorder() : seed(0) {};
+
+		/** \brief Clears the log and seeds sge::random.
+		*
+		* \param uint32 seed : Seed stored in the log.
+		*/
+		void start(uint32 seed);
+
+		void record(const InputEvent& event)
+		{
+			events.push_back(event);
+		}
+
+		/** \brief Writes the log to a binary file.
+		*
+		* \param const std::string& path : File to write.
+		* \return True on success.
+		*/
+		bool save(const std::string& path) const;
+
+		const std::vector<InputEvent>& getEvents() const
+		{
+			return events;
+		}
+
+	private:
+		uint32 seed;
+		std::vector<InputEvent> events;
+	};
+
+	/** \brief Feeds a recorded log back to EventManager in place of the live input. */
+	class InputReplay
+	{
+	public:
+		InputReplay() : seed(0), next(0) {};
+
+		/** \brief Loads a log written by InputRecorder and seeds sge::random with its seed.
+		*
+		* \param const std::string& path : File to read.
+		* \return True on success. The replay is empty if the file is missing or invalid.
+		*/
+		bool load(const std::string& path);
+
+		/** \brief Returns the next event processed before the step, or nullptr if there are none left.
+		*
+		* \param uint32 step : Index of the fixed step about to run.
+		*/
+		const InputEvent* pop(uint32 step)
+		{
+			if (next < events.size() && events[next].step <= step)
+			{
+				return &events[next++];
+			}
+
+			return nullptr;
+		}
+
+		bool isFinished() const
+		{
+			return next == events.size();
+		}
+
+		uint32 getSeed() const
+		{
+			return seed;
+		}
+
+	private:
+		uint32 seed;
+		size_t next; /**< Index of the next event to replay. */
+		std::vector<InputEvent> events;
+	};
+}
@@ -17,7 +17,6 @@ namespace sge
 		ModelComponent(Entity* entity);
 
 		void update();
-		void render(GraphicsDevice* device);
 
 		void setModelResource(sge::Handle <sge::ModelResource>* modelHandle);
 
@@ -2,10 +2,21 @@
 #include "Game/System.h"
 #include "Game/PhysicsComponent.h"
 #include "Game/ComponentFactory.h"
+#include "Core/Math.h"
 #include <vector>
 
 namespace sge
 {
+	/** \brief Published by the PhysicsSystem for every touching pair of bodies after a step. */
+	struct CollisionEvent
+	{
+		Entity* entityA;
+		Entity* entityB;
+		math::vec3 point;	/**< Deepest contact point, in world space on B. */
+		math::vec3 normal;	/**< Contact normal pointing from B to A. */
+		float impulse;		/**< Total impulse applied to the pair. */
+	};
+
 	class PhysicsSystem : public System
 	{
 	public:
@@ -13,8 +24,14 @@ namespace sge
 		~PhysicsSystem();
 
 		void update();
+		/** \brief Steps the simulation.
+		*
+		* Publishes a CollisionEvent for every touching pair to the EventBus, if one is set.
+		* \param float deltaTime : Time to simulate.
+		*/
 		void stepWorld(float deltaTime); // Could also change update to contain deltatime
 		void addComponent(Component* comp);
+		void removeComponent(Component* comp);
 		PhysicsComponent* createPhysicsComponent(Entity* ent);
 
 		btDiscreteDynamicsWorld* getWorld()
@@ -28,7 +45,10 @@ namespace sge
 		}
 
 	private:
+		void publishContacts();
+
 		std::vector<PhysicsComponent*> comps;
+		std::vector<CollisionEvent> contacts; /**< Reused between steps. */
 		sge::ComponentFactory<PhysicsComponent> physFac;
 
 		// Bullet init
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Game/LightComponent.h"
+#include "Game/ComponentReflection.h"
 
 namespace sge
 {
@@ -23,11 +24,16 @@ namespace sge
         PointLightComponent(Entity* ent);
         ~PointLightComponent();
 
+        /** \brief Copies the transform's world position into the light data if it has moved. */
         void update();
 
         const PointLight& getLightData() { return lightData; }
-        void setLightData(const PointLight& data) { lightData = data; }
+        void setLightData(const PointLight& data) { lightData = data; markChanged(); }
+
+        /** \brief Members saved in scene snapshots. */
+        static const ComponentReflection& getReflection();
     private:
         PointLight lightData;
+        unsigned int positionVersion; /**< Change version the position was last copied at. */
     };
 }
\ No newline at end of file
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Game/ComponentFactory.h"
+#include "Game/ComponentReflection.h"
+#include "Game/Entity.h"
+#include "Core/Math.h"
+#include "Core/Types.h"
+
+namespace sge
+{
+	class Component;
+	class EntityManager;
+	class SystemManager;
+
+	/** \brief Placement of one prefab instance.
+	*
+	* Only the position is applied by default, the scale and rotation of the prototype are kept
+	* unless they are overridden with setScale and setRotation.
+	*/
+	struct PrefabTransform
+	{
+		enum Overrides : uint32
+		{
+			SCALE		= 0x01,
+			ROTATION	= 0x02
+		};
+
+		explicit PrefabTransform(const math::vec3& position) :
+			position(position), scale(1.0f), rotationVector(0.0f, 1.0f, 0.0f), angle(0.0f), overrides(0)
+		{
+		}
+
+		PrefabTransform& setScale(const math::vec3& scale)
+		{
+			this->scale = scale;
+			overrides |= SCALE;
+			return *this;
+		}
+
+		PrefabTransform& setRotation(const math::vec3& rotationVector, float angle)
+		{
+			this->rotationVector = rotationVector;
+			this->angle = angle;
+			overrides |= ROTATION;
+			return *this;
+		}
+
+		math::vec3 position;
+		math::vec3 scale;
+		math::vec3 rotationVector;
+		float angle;
+		uint32 overrides;	/**< Overrides flags of the members applied besides the position. */
+	};
+
+	/** \brief Template for entities that share a set of components and their initial values.
+	*
+	* The prefab keeps a prototype of every added component. Configure the prototypes once,
+	* then instantiate() creates any number of entities from them. The components of each type
+	* are created in one contiguous block, and the reflected members of the prototype are
+	* copied into them, so no per entity setup code runs.
+	*
+	* Prefab crate;
+	* crate.add(transforms);
+	* crate.add(lights)->setLightData(...);
+	* crate.add<ModelComponent>(models, [&](ModelComponent* model) { model->setModelResource(&handle); });
+	* crate.instantiate(entityManager, positions.size(), positions.data(), &systemManager);
+	*
+	* Members that aren't reflected, such as resource pointers, are set with the initializer
+	* given to add(), which runs for every instance. Add the types other components look up in
+	* their constructors first, e.g. TransformComponent before the lights.
+	*/
+	class Prefab
+	{
+	public:
+		Prefab() {};
+		~Prefab();
+
+		Prefab(const Prefab&) = delete;
+		void operator=(const Prefab&) = delete;
+
+		/** \brief Adds a component type to the prefab.
+		*
+		* \param ComponentFactory<T>& factory : Factory that creates and owns the instances.
+		* \param const std::function<void(T*)>& init : Called for every instance after the prototype is copied, optional.
+		* \return The prototype, set its values to change the initial values of the instances.
+		*/
+		template <typename T>
+		T* add(ComponentFactory<T>& factory, const std::function<void(T*)>& init = nullptr)
+		{
+			T* prototype = new T(&prototypeEntity);
+			prototypeEntity.setComponent(prototype);
+
+			Entry entry;
+			entry.prototype = prototype;
+			entry.instantiate = [&factory, prototype, init](Entity* const* entities, size_t count, std::vector<Component*>& created)
+			{
+				T* first = factory.createBulk(entities, count);
+
+				for (size_t i = 0; i < count; i++)
+				{
+					copyReflected(prototype, first + i);
+
+					if (init)
+					{
+						init(first + i);
+					}
+
+					created.push_back(first + i);
+				}
+			};
+			entries.push_back(entry);
+
+			return prototype;
+		}
+
+		/** \brief Getter function for the prototype of type T, nullptr if the type wasn't added. */
+		template <typename T>
+		T* getPrototype()
+		{
+			return prototypeEntity.getComponent<T>();
+		}
+
+		/** \brief Sets the tag given to the instances. */
+		void setTag(const std::string& tag)
+		{
+			prototypeEntity.setTag(tag);
+		}
+
+		/** \brief Creates entities from the prefab.
+		*
+		* \param EntityManager& entityManager : Manager that creates the entities.
+		* \param size_t count : Number of entities.
+		* \param const PrefabTransform* transforms : Placement of each entity, applied to its TransformComponent. Nullptr keeps the prototype's.
+		* \param SystemManager* systemManager : Systems the new components are added to, or nullptr.
+		* \return The new entities.
+		*/
+		std::vector<Entity*> instantiate(EntityManager& entityManager, size_t count, const PrefabTransform* transforms = nullptr, SystemManager* systemManager = nullptr);
+
+	private:
+		struct Entry
+		{
+			Component* prototype;
+			std::function<void(Entity* const* entities, size_t count, std::vector<Component*>& created)> instantiate;
+		};
+
+		template <typename T>
+		struct HasReflection
+		{
+			template <typename U>
+			static std::true_type test(decltype(&U::getReflection));
+
+			template <typename U>
+			static std::false_type test(...);
+
+			static const bool value = decltype(test<T>(nullptr))::value;
+		};
+
+		template <typename T>
+		static typename std::enable_if<HasReflection<T>::value>::type copyReflected(const T* source, T* destination)
+		{
+			for (auto& field : T::getReflection().getFields())
+			{
+				std::memcpy(reinterpret_cast<char*>(destination) + field.offset, reinterpret_cast<const char*>(source) + field.offset, field.size);
+			}
+		}
+
+		/** Types without reflection only get the initializer. */
+		template <typename T>
+		static typename std::enable_if<!HasReflection<T>::value>::type copyReflected(const T*, T*)
+		{
+		}
+
+		Entity prototypeEntity; /**< Owner of the prototypes, not managed by any EntityManager. */
+		std::vector<Entry> entries;
+	};
+}
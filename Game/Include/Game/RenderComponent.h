@@ -2,6 +2,7 @@
 
 #include <vector>
 
+#include "Core/Assert.h"
 #include "Game/Component.h"
 #include "Game/CameraComponent.h"
 #include "Renderer/GraphicsDevice.h"
@@ -19,11 +20,22 @@ namespace sge
 		
         void setRenderer(RenderSystem* renderer);
 
-		RenderCommand key;
-        virtual void render(GraphicsDevice* device) = 0;
+        /** \brief Sets the layer of the sort key. Higher layers are drawn later within a camera. */
+        void setLayer(uint32 layer)
+        {
+            SGE_ASSERT(layer < MAX_RENDER_LAYERS);
+            this->layer = layer;
+        }
+        uint32 getLayer() const { return layer; }
+
+        /** \brief Turns off frustum culling, e.g. for a sky box that is drawn around the camera. */
+        void setFrustumCulling(bool enabled) { frustumCulling = enabled; }
+        bool hasFrustumCulling() const { return frustumCulling; }
 
     protected:
         RenderSystem* renderer;
+        uint32 layer;
+        bool frustumCulling;
 	};
 }
 
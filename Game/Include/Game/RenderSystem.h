@@ -1,13 +1,19 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
+#include <map>
 #include <vector>
 #include <string>
 
+#include "Core/Bounds.h"
 #include "Core/Math.h"
 #include "Renderer/GraphicsDevice.h"
+#include "Renderer/RenderCommand.h"
 #include "Renderer/RenderQueue.h"
+#include "Renderer/Viewport.h"
 
+#include "Game/FrameSnapshot.h"
 #include "Game/LightComponent.h"
 #include "Game/PointLightComponent.h"
 #include "Game/DirLightComponent.h"
@@ -18,25 +24,19 @@ namespace sge
     const int MAX_DIR_LIGHTS = 10;
     const int MAX_POINT_LIGHTS = 40;
 	class Window;
+    class ThreadPool;
     class RenderComponent;
     class SpriteComponent;
     class ModelComponent;
     class TextComponent;
     class CameraComponent;
     class Entity;
+    class GlyphAtlas;
+    struct Font;
     struct Pipeline;
     struct Buffer;
     struct Shader;
 
-    struct Character
-    {
-        sge::math::vec2 size;
-        sge::math::vec2 horiBearing;
-        sge::math::vec2 vertBearing;
-        sge::math::vec2 metrics;
-		sge::math::vec2 advance;
-    };
-
     enum Clear
     {
         QUEUE           = 0x01,
@@ -55,6 +55,13 @@ namespace sge
 	class RenderSystem
 	{
 	public:
+        /** \brief Sprites and models that were pushed to the queue and ones left out by frustum culling, once per camera. */
+        struct CullCounters
+        {
+            size_t visible;
+            size_t culled;
+        };
+
         RenderSystem(Window& window);
         ~RenderSystem();
 
@@ -69,43 +76,125 @@ namespace sge
         void renderModels(size_t count, Entity* models[]);
         void renderLights(size_t count, Entity* lights[]);
 
+        /** \brief Adds the cameras as views of the next begin(), the views are drawn in the order they were added.
+        *
+        * A frame has at most 2^viewBits views, see SortKeyLayout.
+        */
         void addCameras(size_t count, Entity* cameras[]);
         void setRenderTarget(RenderTarget* renderTarget);
 
 		void begin();
+
+        /** \brief Begins a frame drawn from a snapshot instead of from entities.
+        *
+        * The cameras of the snapshot are the views and its sprites, texts, models and lights
+        * are pushed right away, the added cameras and lights aren't used. Nothing is read from
+        * components, so the simulation can run meanwhile. The snapshot must not change until end().
+        * \param const FrameSnapshot& snapshot : Frame to draw.
+        */
+        void begin(const FrameSnapshot& snapshot);
 		void end();
         void render();
         void present();
         void clear(int flags = ALL);
 
-        // TODO one should not directly use these methods!
-        void renderSprite(SpriteComponent* sprite);
-        void renderText(TextComponent* text);
-        void renderModel(ModelComponent* model);
+        /** \brief Sets the pool the views are recorded and the render queue is sorted with. Null works on the calling thread. */
+        void setThreadPool(ThreadPool* pool)
+        {
+            this->pool = pool;
+            queue.setThreadPool(pool);
+        }
+
+        /** \brief Encoder of the queue's sort keys, change its layout or depth range to fit the scene. */
+        SortKeyEncoder& getSortKeyEncoder() { return keyEncoder; }
+
+        /** \brief Culling counts of all views since begin(). */
+        CullCounters getCullCounters() const;
 
         void setClearColor(float r, float g, float b, float a);
         void setClearColor(const math::vec4& color);
 
 	private:
-        
+        /** \brief Camera data of one view, copied in begin() so the views can be recorded in parallel.
+        *
+        * The index of a view is the view of the sort keys it pushes and the queue segment it pushes into,
+        * so each view has its own range of keys and no view waits on another while recording.
+        */
+        struct RenderView
+        {
+            Viewport viewport;
+            math::mat4 viewProj;
+            math::vec3 position;
+            math::vec3 front;
+            RenderTarget* renderTarget;
+            uint32 layerMask;
+            Frustum frustum;
+            CullCounters cullCounters;
+        };
+
         void initShaders();
         void initSpriteRendering();
         void initTextRendering();
         void initModelRendering();
 
+        /** \brief Creates the views of the cameras and starts accepting commands. */
+        void beginViews(const std::vector<FrameSnapshot::Camera>& viewCameras);
+
+        // Push the entries first..first + count of the frame to the queue.
+        void pushSprites(const FrameSnapshot& frame, size_t first, size_t count);
+        void pushTexts(const FrameSnapshot& frame, size_t first, size_t count);
+        void pushModels(const FrameSnapshot& frame, size_t first, size_t count);
+
         void calculateLightData();
+        void calculateSnapshotLightData();
+
+        /** \brief Calls the task once per view, on the thread pool if there is more than one. */
+        void forEachView(const std::function<void(size_t)>& task);
+
+        /** \brief True if the view draws entries of the layer. */
+        static bool drawsLayer(const RenderView& view, uint32 layer)
+        {
+            return layer < MAX_RENDER_LAYERS && (view.layerMask & (1u << layer)) != 0;
+        }
+
+        /** \brief Binds the target of the view, or the one set with setRenderTarget, and clears the view's own. */
+        void beginViewTarget(const RenderView& view);
+
+        /** \brief Binds the target while render() draws, null for the back buffer. */
+        void bindTarget(RenderTarget* target);
+
+        /** \brief Distance of the position in front of the view, the depth of the sort key. */
+        float getDepth(const RenderView& view, const math::vec3& position) const;
+
+        // Executes the packets of the queue.
+        void drawSprite(const DrawSpritePacket& packet);
+        size_t drawSprites(const RenderQueue::Item* items, size_t count);
+        void drawText(const DrawTextPacket& packet, const char* text);
+        void drawMesh(const DrawMeshPacket& packet);
+
+        /** \brief Atlas of the font at its current size, created on first use. */
+        GlyphAtlas* getGlyphAtlas(Font* font);
 		
 		RenderQueue queue;
+        SortKeyEncoder keyEncoder;
         GraphicsDevice* device;
+        ThreadPool* pool;
+        RenderTarget* renderTarget;		/**< Set with setRenderTarget, views without their own target draw into it. */
+        RenderTarget* boundTarget;		/**< Target bound while render() draws. */
         math::vec4 clearColor;
 
-        // Sprite rendering data.
+        // Sprite rendering data. Sprites with the default pipeline are drawn instanced, the uniform
+        // buffers are used for sprites with their own pipeline.
+        static const size_t MAX_SPRITE_INSTANCES = 128; // Must match the instance array of the sprite shader.
+
         Pipeline* sprPipeline;
         Buffer* sprVertexBuffer;
         Buffer* sprVertexUniformBuffer;
         Buffer* sprPixelUniformBuffer;
+        Buffer* sprInstanceBuffer;
         Shader* sprVertexShader;
-        Shader* sprPixelShader;
+        Shader* sprInstanceVertexShader;
+        Shader* sprInstancePixelShader;
 		
 #ifdef DIRECTX11
         __declspec(align(16))
@@ -123,55 +212,108 @@ namespace sge
             math::vec4 color;
         } sprPixelUniformData;
 
+#ifdef DIRECTX11
+        __declspec(align(16))
+#endif
+        struct SprInstanceData
+        {
+            math::mat4 MVP;
+            math::vec4 color;
+        } sprInstanceData[MAX_SPRITE_INSTANCES];
+
         // Text rendering data.
         Pipeline* textPipeline;
         Buffer* textVertexBuffer;
         Shader* textPixelShader;
 
-        // Model rendering data.
-        Buffer* modelVertexUniformBuffer;
-        Buffer* modelPixelUniformBuffer;
+        // Position and texcoord of a glyph quad corner.
+        static const size_t TEXT_VERTEX_FLOATS = 5;
+        static const size_t MAX_TEXT_GLYPHS = 256;
 
-#ifdef DIRECTX11
-        __declspec(align(16))
-#endif
-        struct ModelVertexUniformData
+        std::map<std::pair<const void*, uint32>, GlyphAtlas*> glyphAtlases;	/**< By font face and pixel size. */
+        std::vector<std::vector<float>> textVertices;						/**< Glyph quads of the current string by atlas page. */
+
+        // Model rendering data. The uniforms are split by how often they change. The lights are
+        // uploaded when they change, the camera when the sorted draws reach another view and the
+        // material when they reach another material. The matrices change every draw and are
+        // written to a stream buffer instead of reallocating a buffer for each mesh. The stream size is
+        // per frame, about a thousand draws, the device grows the buffer for frames that draw more.
+        static const size_t MODEL_STREAM_SIZE = 256 * 1024;
+
+        Buffer* modelDrawUniformBuffer;			/**< Vertex binding 0, stream buffer. */
+        Buffer* modelFrameUniformBuffer;		/**< Pixel binding 1. */
+        Buffer* modelCameraUniformBuffer;		/**< Pixel binding 2. */
+        Buffer* modelMaterialUniformBuffer;		/**< Pixel binding 3. */
+
+        struct ModelDrawUniformData
         {
             sge::math::mat4 PV;
             sge::math::mat4 M;
 			float shininess;
-        } modelVertexUniformData;
+			float pad[3];	/**< The bound range covers the whole std140 block. */
+        };
 
 #ifdef DIRECTX11
         __declspec(align(16))
 #endif
-        struct ModelPixelUniformData
+        struct ModelFrameUniformData
         {
             DirLight dirLights[MAX_DIR_LIGHTS];
             PointLight pointLights[MAX_POINT_LIGHTS];
-            sge::math::vec4 CamPos;
             float numofpl;
 			float numofdl;
 			float numofsl;
+			float pad;
+        } modelFrameUniformData;
+
+#ifdef DIRECTX11
+        __declspec(align(16))
+#endif
+        struct ModelCameraUniformData
+        {
+            sge::math::vec4 CamPos;
+        } modelCameraUniformData;
+
+#ifdef DIRECTX11
+        __declspec(align(16))
+#endif
+        struct ModelMaterialUniformData
+        {
 			float glossyness;
 			int hasDiffuseTex;
 			int hasNormalTex;
 			int hasSpecularTex;
 			int hasCubeTex;
-			float pad;
-        } modelPixelUniformData;
+			float pad[3];
+        } modelMaterialUniformData;
 
-        // Text rendering data.
-        std::vector<sge::Texture*> charTextures; // TODO who deletes these?
-        std::vector<Character> characters;
-        std::string previousText = "";
+        bool frameUniformsChanged;		/**< Lights changed since modelFrameUniformBuffer was uploaded. */
+        bool cameraUniformsValid;
+        bool materialUniformsValid;
+
+        // Frustum culling data. The bounds are computed once per render call and tested by every view.
+        std::vector<BoundingSphere> cullSpheres;	/**< World bounds of the entities being pushed. */
+        std::vector<uint8> cullVisibility;			/**< cullVisibility[view * count + i], each view writes its own part. */
+        std::vector<AABB> cullModelBounds;			/**< World bounds of the models. */
+        std::vector<AABB> cullMeshBounds;			/**< World bounds of the meshes of all models. */
+        std::vector<size_t> cullMeshOffsets;		/**< Index of the first mesh of each model in cullMeshBounds. */
 
         // Global rendering data.
         std::vector<CameraComponent*> cameras;
+        std::vector<RenderView> views;				/**< Of the cameras, copied in begin(). */
         std::vector<SpotLightComponent*> spotLights;
         std::vector<DirLightComponent*> dirLights;
         std::vector<PointLightComponent*> pointLights;
 
+        // Lights copied into modelFrameUniformData and the change version they were copied at.
+        std::vector<DirLightComponent*> uploadedDirLights;
+        std::vector<PointLightComponent*> uploadedPointLights;
+        unsigned int lightVersion;
+        bool lightsFromSnapshot;		/**< modelFrameUniformData holds the lights of a snapshot. */
+
+        FrameSnapshot liveFrame;				/**< Entities rendered since begin(), copied like a snapshot. */
+        const FrameSnapshot* snapshot;			/**< Drawn since begin(const FrameSnapshot&), null when drawing entities. */
+
         bool initialized;
         bool acceptingCommands;
 	};
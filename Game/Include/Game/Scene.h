@@ -2,6 +2,9 @@
 
 namespace sge
 {
+	class ThreadPool;
+	class FrameSnapshot;
+
 	class Scene
 	{
 	public:
@@ -9,5 +12,35 @@ namespace sge
 		virtual void update(float step) = 0;
 		virtual void interpolate(float alpha) = 0;
 		virtual void draw() = 0;
+
+		/** \brief Loads the CPU side data of the scene.
+		*
+		* Called once before the scene becomes active. With SceneManager::changeAsync and pushAsync
+		* it runs on a loader thread while the current scene keeps running, so it must not use the
+		* graphics device or the current scene. Resources and the scene's own entities and components
+		* can be created, the ResourceManager and the allocator are thread safe. Files can be loaded
+		* in parallel with the pool.
+		* \param ThreadPool& pool : Pool for loading work, shared with the rest of the engine.
+		*/
+		virtual void load(ThreadPool&) {};
+
+		/** \brief Creates the GPU resources of the scene a few at a time.
+		*
+		* Called on the main thread once a frame after load() until it returns true, then the scene
+		* becomes active. Keep the work done per call small so the frame rate doesn't drop.
+		* \return True when everything is ready.
+		*/
+		virtual bool prepare() { return true; };
+
+		/** \brief Copies the state draw() needs out of the simulation.
+		*
+		* Called every frame after interpolate(), on the thread that ran it. The engine keeps two
+		* snapshots and draw() gets the other one from Spade::getFrameSnapshot, so with a pipelined
+		* engine the next frame can simulate while this one is drawn. draw() must then only read
+		* the snapshot and the renderer, see RenderSystem::begin(const FrameSnapshot&).
+		* \param FrameSnapshot& snapshot : Empty snapshot to fill.
+		* \return False if the scene draws straight from its components, the frames then run serially.
+		*/
+		virtual bool snapshot(FrameSnapshot&) { return false; };
 	};
-}
\ No newline at end of file
+}
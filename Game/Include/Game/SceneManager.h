@@ -1,5 +1,9 @@
 #pragma once
 #include "Game/Scene.h"
+#include "Core/ThreadPool.h"
+
+#include <atomic>
+#include <thread>
 #include <vector>
 
 namespace sge
@@ -7,7 +11,12 @@ namespace sge
 	class SceneManager
 	{
 	public:
-		SceneManager();
+		/** \brief The constructor.
+		*
+		* \param ThreadPool& pool : Pool given to Scene::load. Scenes load one at a time on a single
+		* loader thread, the pool only spreads the work of one load.
+		*/
+		SceneManager(ThreadPool& pool);
 		~SceneManager();
 
 		enum SceneAction
@@ -21,14 +30,57 @@ namespace sge
 		void update(float step);
 		void interpolate(float alpha);
 		void draw();
+
+		/** \brief Lets the active scene copy its drawable state, see Scene::snapshot. */
+		bool snapshot(FrameSnapshot& snapshot);
+
 		void push(Scene* scene);
 		void pop();
 		void change(Scene* scene);
-		void handleScenes();
+
+		/** \brief Changes to a scene once it has loaded in the background.
+		*
+		* Scene::load runs on a loader thread while the current scene keeps running. After that
+		* handleScenes calls Scene::prepare once a frame, and switches when it's done.
+		* Only one scene can load at a time.
+		* \param Scene* scene : Scene to change to. Its constructor should leave the loading to Scene::load.
+		*/
+		void changeAsync(Scene* scene);
+
+		/** \brief Pushes a scene once it has loaded in the background, see changeAsync. */
+		void pushAsync(Scene* scene);
+
+		/** \brief True while a scene given to changeAsync or pushAsync isn't active yet. */
+		bool isLoading() const
+		{
+			return loadingScene != nullptr;
+		}
+
+		/** \brief Applies the scene changes requested since the last call.
+		*
+		* \return True if another scene became active.
+		*/
+		bool handleScenes();
 	private:
+		void startLoading(Scene* scene, SceneAction action);
+
+		/** \brief Loads and prepares the scene on the calling thread.
+		*
+		* Waits for a pending async load first, then runs the scene's prepare() steps back to back.
+		*/
+		void loadNow(Scene* scene);
+
+		void apply(SceneAction action, Scene* scene);
+
 		std::vector<Scene*> scenes;
 
 		SceneAction sceneAction;
 		Scene* newScene;
+
+		ThreadPool& pool;				/**< Workers a loading scene can spread its files over. */
+		std::thread loader;
+		std::atomic<bool> loaded;		/**< Set by the loader thread when Scene::load has returned. */
+		Scene* loadingScene;
+		SceneAction loadingAction;
 	};
 };
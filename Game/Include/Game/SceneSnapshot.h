@@ -0,0 +1,146 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Game/ComponentFactory.h"
+#include "Game/ComponentReflection.h"
+#include "Game/Entity.h"
+#include "Core/Types.h"
+
+namespace sge
+{
+	class Component;
+	class EntityManager;
+	class SystemManager;
+
+	/** \brief Saves entities and their reflected components to a binary file and loads them back.
+	*
+	* Loading maps the file and copies every reflected member straight from the mapping into
+	* the new components, so no scene construction code is replayed. Entity tags and the
+	* transform hierarchy are kept too.
+	*
+	* Bind the factory of every component type that should be saved or loaded. Types are
+	* written and loaded in the order they were bound, so bind the types other components
+	* look up in their constructors first, e.g. TransformComponent before the lights.
+	* Types in a file that aren't bound are skipped, as are members that no longer exist.
+	*
+	* File layout, version 1:
+	* - FileHeader
+	* - EntityRecord for every entity
+	* - Tag strings, zero terminated
+	* - For every component type: ChunkHeader, FieldRecord per member, then one record per
+	*   component: the index of its entity followed by the member data in FieldRecord order.
+	*/
+	class SceneSnapshot
+	{
+	public:
+		static const uint32 VERSION = 1;
+
+		/** \brief Binds the factory that creates and owns Components of type T.
+		*
+		* T must provide a static getReflection() function.
+		* \param ComponentFactory<T>& factory : Factory of the type.
+		*/
+		template <typename T>
+		void bind(ComponentFactory<T>& factory)
+		{
+			Binding binding = { &T::getReflection(), &factory, &createComponent<T>, &collectComponents<T> };
+			bindings.push_back(binding);
+		}
+
+		/** \brief Saves every entity of the manager and its bound components.
+		*
+		* \param const std::string& path : File to write.
+		* \param EntityManager& entityManager : Entities to save.
+		* \return True on success.
+		*/
+		bool save(const std::string& path, EntityManager& entityManager);
+
+		/** \brief Creates the entities and components stored in a file.
+		*
+		* \param const std::string& path : File to read.
+		* \param EntityManager& entityManager : Manager that creates the entities.
+		* \param SystemManager* systemManager : Systems the new components are added to, or nullptr.
+		* \return True on success. Nothing is created if the file is missing or invalid.
+		*/
+		bool load(const std::string& path, EntityManager& entityManager, SystemManager* systemManager = nullptr);
+
+		/** \brief Entities created by the last load, in the order they were saved. */
+		const std::vector<Entity*>& getLoadedEntities() const
+		{
+			return loaded;
+		}
+
+	private:
+		using CreateFunction = void* (*)(void* factory, Entity* entity, Component** component);
+		using CollectFunction = void(*)(void* factory, std::vector<const void*>& objects, std::vector<Entity*>& owners);
+
+		/** \brief Type erased access to a bound factory. Objects are passed as T* since reflected offsets are relative to T. */
+		struct Binding
+		{
+			const ComponentReflection* reflection;
+			void* factory;
+			CreateFunction create;
+			CollectFunction collect;
+		};
+
+		struct FileHeader
+		{
+			char magic[4];
+			uint32 version;
+			uint32 entityCount;
+			uint32 stringsSize;
+			uint32 chunkCount;
+		};
+
+		struct EntityRecord
+		{
+			uint32 tag;		/**< Offset of the tag in the strings. */
+			uint32 parent;	/**< Index of the entity owning the parent transform, or NO_PARENT. */
+		};
+
+		struct ChunkHeader
+		{
+			uint32 typeId;
+			uint32 fieldCount;
+			uint32 recordSize;
+			uint32 count;
+		};
+
+		struct FieldRecord
+		{
+			uint32 nameHash;
+			uint32 size;
+		};
+
+		static const uint32 NO_PARENT = 0xffffffffu;
+
+		template <typename T>
+		static void* createComponent(void* factory, Entity* entity, Component** component)
+		{
+			T* created = static_cast<ComponentFactory<T>*>(factory)->create(entity);
+			*component = created;
+			return created;
+		}
+
+		template <typename T>
+		static void collectComponents(void* factory, std::vector<const void*>& objects, std::vector<Entity*>& owners)
+		{
+			const std::vector<T*>& components = static_cast<ComponentFactory<T>*>(factory)->getComponents();
+
+			objects.assign(components.begin(), components.end());
+			owners.clear();
+
+			for (auto component : components)
+			{
+				owners.push_back(component->getParent());
+			}
+		}
+
+		const Binding* findBinding(uint32 typeId) const;
+
+		std::vector<Binding> bindings;
+		std::vector<Entity*> loaded;
+	};
+}
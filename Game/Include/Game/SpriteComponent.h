@@ -16,7 +16,6 @@ namespace sge
 		SpriteComponent(Entity* ent);
 		SpriteComponent(Entity* ent, sge::Texture* texture, const sge::math::vec4& col);
 		~SpriteComponent();
-		void render(GraphicsDevice* device);
 		void update();
 
 		void setTexture(Texture* texture);
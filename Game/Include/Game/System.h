@@ -1,13 +1,20 @@
 #pragma once
 #include "Game/Component.h"
+#include "Game/EntityCommandBuffer.h"
+#include "Game/EventBus.h"
+#include "Core/ThreadPool.h"
+
+#include <typeinfo>
+#include <vector>
 
 namespace sge
 {
 	class System
 	{
 	public:
+		System() : phase(0), pool(nullptr), events(nullptr), lastRunVersion(0), runVersion(0) {};
 		virtual ~System() {};
-		
+
 		/** \brief Pure virtual function for Component addition
 		*
 		* Overwritten by systems, used by all systems to add a type of Component
@@ -16,5 +23,107 @@ namespace sge
 		*/
 		virtual void addComponent(Component* comp) = 0;
 		virtual void update() = 0;
+
+		/** \brief Removes a Component from the System before it's destroyed.
+		*
+		* \param Component* comp : Component to be removed.
+		*/
+		virtual void removeComponent(Component*) {};
+
+		/** \brief Buffer for structural changes made during update.
+		*
+		* Systems and their workers record entity and component creation and removal here
+		* instead of changing them mid iteration. The SystemManager plays the buffer back
+		* at the end of the System's phase.
+		*/
+		EntityCommandBuffer& getCommands() { return commands; }
+
+		/** \brief Component types the System reads during update.
+		*
+		* Types are identified by typeid(T).hash_code(), same as in the SystemManager.
+		*/
+		const std::vector<size_t>& getReadTypes() const { return readTypes; }
+
+		/** \brief Component types the System writes during update. */
+		const std::vector<size_t>& getWriteTypes() const { return writeTypes; }
+
+		/** \brief Whether the System has declared its component access at all.
+		*
+		* Systems that declare nothing are never run alongside other systems.
+		*/
+		bool declaresAccess() const { return !readTypes.empty() || !writeTypes.empty(); }
+
+		/** \brief Sets the update phase. Phases are updated in ascending order, one after another.
+		*
+		* Set the phase and the component access before adding the System to a SystemManager.
+		*/
+		void setPhase(unsigned int phase) { this->phase = phase; }
+		unsigned int getPhase() const { return phase; }
+
+		/** \brief Sets the worker pool used by parallelFor. Null runs everything on the calling thread. */
+		void setThreadPool(ThreadPool* pool) { this->pool = pool; }
+
+		/** \brief Sets the EventBus the System publishes to and reads from. Set by the SystemManager. */
+		void setEventBus(EventBus* events) { this->events = events; }
+		EventBus* getEventBus() { return events; }
+
+		/** \brief Advances the change versions before an update. Called by the SystemManager. */
+		void beginUpdate()
+		{
+			lastRunVersion = runVersion;
+			runVersion = Component::nextChangeVersion();
+		}
+
+		/** \brief Change version of the previous update.
+		*
+		* Components with comp->hasChangedSince(getLastRunVersion()) changed after the System
+		* last ran, the rest can be skipped.
+		*/
+		unsigned int getLastRunVersion() const { return lastRunVersion; }
+
+	protected:
+		/** \brief Declares that the System reads Components of type T. */
+		template <typename T>
+		void readsComponent()
+		{
+			readTypes.push_back(typeid(T).hash_code());
+		}
+
+		/** \brief Declares that the System reads and writes Components of type T. */
+		template <typename T>
+		void writesComponent()
+		{
+			writeTypes.push_back(typeid(T).hash_code());
+		}
+
+		/** \brief Processes [0, count) in chunks, concurrently when a worker pool is set.
+		*
+		* The function receives the [begin, end) range of each chunk and must not touch
+		* elements outside of it.
+		* \param size_t count : Number of elements.
+		* \param size_t chunkSize : Maximum number of elements per chunk.
+		* \param const ThreadPool::RangeTask& function : Function called for each chunk.
+		*/
+		void parallelFor(size_t count, size_t chunkSize, const ThreadPool::RangeTask& function)
+		{
+			if (pool)
+			{
+				pool->parallelFor(count, chunkSize, function);
+			}
+			else if (count > 0)
+			{
+				function(0, count);
+			}
+		}
+
+	private:
+		std::vector<size_t> readTypes;
+		std::vector<size_t> writeTypes;
+		EntityCommandBuffer commands;
+		unsigned int phase;
+		ThreadPool* pool;
+		EventBus* events;
+		unsigned int lastRunVersion;
+		unsigned int runVersion;
 	};
 }
@@ -1,7 +1,11 @@
 #pragma once
 #include <unordered_map>
+#include <vector>
 #include "Game/System.h"
 #include "Game/Component.h"
+#include "Game/EntityManager.h"
+#include "Game/EventBus.h"
+#include "Core/ThreadPool.h"
 
 namespace sge
 {
@@ -9,7 +13,14 @@ namespace sge
 	{
 	public:
 		using Systems = std::unordered_map<size_t, System*>;
-		
+		using Stage = std::vector<System*>;
+
+		/** \brief Constructor.
+		*
+		* \param size_t workerCount : Number of worker threads used to run systems concurrently.
+		*/
+		SystemManager(size_t workerCount = ThreadPool::getDefaultWorkerCount());
+
 		/** \brief Adds a Component to a System.
 		*
 		* Uses the map to find the correct System for the Component and adds it
@@ -18,9 +29,17 @@ namespace sge
 		*/
 		void addComponent(Component* comp);
 
+		/** \brief Removes a Component from its System.
+		*
+		* Call before the Component is destroyed.
+		* \param Component* comp : Pointer to a type of Component.
+		*/
+		void removeComponent(Component* comp);
+
 		/** \brief Adds a System and a Component to a map.
 		*
 		* Pairs and adds a System and a Component to the systems map.
+		* Systems are updated in the order they were first added.
 		* \param System* system : Pointer to a System.
 		* \param size_t type : Type of Component.
 		*/
@@ -28,12 +47,61 @@ namespace sge
 
 		/** \brief Updates all Systems.
 		*
-		* Calls the update functions of all Systems.
+		* Calls the update functions of all Systems, phase by phase. Inside a phase, systems
+		* whose declared component access doesn't conflict are updated concurrently. Conflicting
+		* systems keep the order they were added in, so the result is the same as a serial update.
+		* The command buffers of a phase's systems are played back after the phase, in the order
+		* the systems were added. Events published since the previous update are dispatched first.
 		*/
 		void updateSystems();
 
+		/** \brief Enables serial mode.
+		*
+		* In serial mode every System is updated on the calling thread in phase and registration order.
+		* Useful for debugging.
+		* \param bool serial : True to disable concurrent updates.
+		*/
+		void setSerial(bool serial);
+
+		bool isSerial() const
+		{
+			return serial;
+		}
+
+		/** \brief Sets the EntityManager used to play back the systems' command buffers.
+		*
+		* Without one the buffers are left untouched.
+		* \param EntityManager* entityManager : Manager that owns the entities.
+		*/
+		void setEntityManager(EntityManager* entityManager)
+		{
+			this->entityManager = entityManager;
+		}
+
+		/** \brief Getter function for the EventBus shared by all added systems. */
+		EventBus& getEventBus()
+		{
+			return events;
+		}
+
 	private:
+		/** \brief Builds the update stages from the ordered systems and their declared access. */
+		void buildStages();
+
+		/** \brief Plays back the command buffers of every System in the phase. */
+		void playbackCommands(unsigned int phase);
+
 		Systems systems; /**< Map used to find what Component goes to which System. */
+		std::vector<System*> ordered; /**< Systems in the order they were added. */
+		std::vector<Stage> stages; /**< Groups of non-conflicting systems, updated one group at a time. */
+		std::vector<size_t> phaseEnds; /**< Index one past the last stage of each phase. */
+
+		EntityManager* entityManager;
+		EventBus events;
+
+		ThreadPool pool;
+		bool serial;
+		bool dirty; /**< Stages need to be rebuilt. */
 	};
 }
 
@@ -27,6 +27,13 @@ namespace sge
 		*/
 		void addComponent(Component* comp);
 
+		/** \brief Function for removing Components.
+		*
+		* Removes the Component from the vector of its type.
+		* \param Component* comp : Pointer to a type of Component.
+		*/
+		void removeComponent(Component* comp);
+
 	private:
 		std::vector<TestComponent*> comps1; /**< Vector containing TestComponent pointers. */
 		std::vector<InputComponent*> comps2; /**< Vector containing InputComponent pointers. */
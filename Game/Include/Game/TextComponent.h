@@ -16,7 +16,6 @@ namespace sge
 		TextComponent(Entity* ent, sge::Font* font, const sge::math::vec4& col);
 		~TextComponent();
 
-		void render(GraphicsDevice* device);
 		void update();
 
 		void setFont(sge::Font* font);
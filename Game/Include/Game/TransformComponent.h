@@ -1,7 +1,10 @@
 #pragma once
 #include "Game/Component.h"
+#include "Game/ComponentReflection.h"
 #include "Core/Math.h"
 
+#include <vector>
+
 namespace sge
 {
 
@@ -9,52 +12,87 @@ namespace sge
 	{
 	public:
 		TransformComponent(Entity* ent);
+		~TransformComponent();
 
-        void update() {};
+		/** \brief Recomputes the cached matrices if the transform or one of its parents has changed. */
+        void update()
+        {
+            if (worldDirty)
+            {
+                updateMatrix();
+            }
+        }
+
+		/** \brief Attaches the transform to a parent transform.
+		*
+		* The world matrix becomes parent world * local. Position, scale and rotation
+		* stay relative to the parent.
+		* \param TransformComponent* parent : New parent, or nullptr to detach.
+		*/
+		void setParentTransform(TransformComponent* parent);
+
+		TransformComponent* getParentTransform()
+		{
+			return parentTransform;
+		}
+
+		const std::vector<TransformComponent*>& getChildTransforms()
+		{
+			return childTransforms;
+		}
 
 		void setPosition(const math::vec3& p)
 		{
 			position = p;
+			markDirty();
 		}
 
         void addPosition(const math::vec3& p)
         {
             position += p;
+            markDirty();
         }
 
         void addAngle(float a)
         {
             angle += a;
+            markDirty();
         }
 
 		void setScale(const math::vec3& s)
 		{
 			scale = s;
+			markDirty();
 		}
 
 		void setRotationVector(const math::vec3& rv)
 		{
 			rotationVector = rv;
+			markDirty();
 		}
 
         void setFront(const math::vec3& f)
         {
             front = f;
+            markChanged();
         }
 
         void setUp(const math::vec3& u)
         {
             up = u;
+            markChanged();
         }
 
         void setLeft(const math::vec3& l)
         {
             left = l;
+            markChanged();
         }
 
 		void setAngle(float a)
 		{
 			angle = a;
+			markDirty();
 		}
 
 		const math::vec3& getPosition()
@@ -92,18 +130,62 @@ namespace sge
 			return angle;
 		}
 
-		const math::mat4 getMatrix()
+		/** \brief Getter function for the world matrix.
+		*
+		* Returns the cached matrix. Usually TransformSystem has already recomputed it for
+		* the frame, otherwise it is recomputed here. Recomputing stamps the change version,
+		* so call this before checking hasChangedSince() to catch parent movement too.
+		* \return The world matrix.
+		*/
+		const math::mat4& getMatrix()
+		{
+			if (worldDirty)
+			{
+				updateMatrix();
+			}
+
+			return worldMatrix;
+		}
+
+		/** \brief Getter function for the position in world space. */
+		math::vec3 getWorldPosition()
 		{
-			return
-				math::translate(math::mat4(1.0f), position) *
-				math::rotate(math::mat4(1.0f), angle, rotationVector) *
-				math::scale(math::mat4(1.0f), scale);
+			return math::vec3(getMatrix()[3]);
 		}
 
+		/** \brief Getter function for the local translate * rotate * scale matrix. */
+		const math::mat4& getLocalMatrix()
+		{
+			if (dirty)
+			{
+				updateMatrix();
+			}
+
+			return localMatrix;
+		}
+
+		bool isDirty() const
+		{
+			return worldDirty;
+		}
+
+		/** \brief Recomputes the local matrix if needed and the world matrix from the parent's, then clears the dirty flags. */
+		void updateMatrix();
+
+		/** \brief Counter bumped whenever any transform is reparented. Lets systems know when to re-sort. */
+		static unsigned int getHierarchyVersion()
+		{
+			return hierarchyVersion;
+		}
+
+		/** \brief Members saved in scene snapshots. The parent is stored by the snapshot itself. */
+		static const ComponentReflection& getReflection();
+
         void lookAt(const math::vec3& target)
         {
             front = math::normalize(target - position);
             up = math::cross(front, left);
+            markChanged();
         }
 
 	private:
@@ -115,6 +197,26 @@ namespace sge
         math::vec3 left;
 
 		float angle;
+
+		/** \brief Flags the local matrix and the world matrices of the whole subtree as out of date. */
+		void markDirty()
+		{
+			dirty = true;
+			markChanged();
+			markWorldDirty();
+		}
+
+		void markWorldDirty();
+
+		math::mat4 localMatrix;
+		math::mat4 worldMatrix;
+		bool dirty; /**< Local matrix is out of date. Only set by the setters. */
+		bool worldDirty; /**< World matrix is out of date. Always set on the whole subtree. */
+
+		TransformComponent* parentTransform;
+		std::vector<TransformComponent*> childTransforms;
+
+		static unsigned int hierarchyVersion;
 	};
 
 }
\ No newline at end of file
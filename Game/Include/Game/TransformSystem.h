@@ -11,10 +11,35 @@ namespace sge
 		TransformSystem();
 		~TransformSystem();
 
+		/** \brief Recomputes the matrices of every dirty transform.
+		*
+		* Runs once per frame as a single pass over all transforms in hierarchy order,
+		* parents before their children, so rendering only reads the cached matrices.
+		* Subtrees without changes are skipped.
+		*/
 		void update();
 		void addComponent(Component* comp);
+		void removeComponent(Component* comp);
+
+		/** \brief Updates independent root subtrees concurrently when a worker pool is available. */
+		void setParallelSubtrees(bool parallel)
+		{
+			parallelSubtrees = parallel;
+		}
 
 	private:
+		/** \brief Sorts the transforms depth first so every subtree is a contiguous range. */
+		void sortHierarchy();
+
+		/** \brief Updates the dirty transforms in [begin, end). Parents must come before their children. */
+		void updateRange(size_t begin, size_t end);
+
 		std::vector<TransformComponent*> comps;
+		std::vector<TransformComponent*> ordered; /**< Transforms in hierarchy order. */
+		std::vector<size_t> rootBegins; /**< Start of each root subtree in ordered, plus the end. */
+
+		unsigned int hierarchyVersion; /**< TransformComponent hierarchy version ordered was built from. */
+		bool sorted;
+		bool parallelSubtrees;
 	};
 }
@@ -13,7 +13,11 @@ namespace sge
         viewport({ 0, 0, 0, 0 }),
         viewProj(0.0f),
         proj(0.0f),
-        transform(nullptr)
+        transform(nullptr),
+        renderTarget(nullptr),
+        layerMask(~0u),
+        viewVersion(0),
+        projChanged(true)
 	{
 		transform = getParent()->getComponent<TransformComponent>();
 
@@ -23,11 +27,13 @@ namespace sge
     void CameraComponent::setPerspective(float fov, float aspectRatio, float near, float far)
     {
         proj = math::perspective(math::radians(fov), aspectRatio, near, far);
+        projChanged = true;
     }
 
     void CameraComponent::setOrtho(float left, float right, float bottom, float top, float near, float far)
     {
         proj = math::ortho(left, right, bottom, top, near, far);
+        projChanged = true;
     }
 
     void CameraComponent::setViewport(int x, int y, unsigned int width, unsigned int height)
@@ -36,6 +42,7 @@ namespace sge
         viewport.y = y;
         viewport.width = width;
         viewport.height = height;
+        markChanged();
     }
 
     void CameraComponent::setViewport(const Viewport& viewport)
@@ -45,14 +52,28 @@ namespace sge
 
 	void CameraComponent::update()
 	{
+        // Brings the transform's change version up to date.
+        transform->getMatrix();
+
+        if (!projChanged && !transform->hasChangedSince(viewVersion))
+        {
+            return;
+        }
+
+        viewVersion = Component::nextChangeVersion();
+        projChanged = false;
+
         updateView();
+        markChanged();
 	}
 
     void CameraComponent::updateView()
     {
+        math::vec3 position = transform->getWorldPosition();
+
         viewProj = proj * sge::math::lookAt(
-            transform->getPosition(), 
-            transform->getPosition() + transform->getFront(), 
+            position,
+            position + transform->getFront(),
             transform->getUp());
     }
 }
\ No newline at end of file
@@ -1,9 +1,17 @@
 #include "Game/Component.h"
 #include "Core/Assert.h"
 
+#include <atomic>
+
 namespace sge
 {
-	Component::Component(Entity* ent) : parent(ent)
+	namespace
+	{
+		// Starts above zero so new components count as changed for a first run with version 0.
+		std::atomic<unsigned int> globalVersion(1);
+	}
+
+	Component::Component(Entity* ent) : parent(ent), changeVersion(globalVersion.load(std::memory_order_relaxed))
 	{
 		SGE_ASSERT(ent != nullptr); // Ensure that we have an entity to work with
 	}
@@ -12,4 +20,14 @@ namespace sge
 	Component::~Component()
 	{
 	}
+
+	void Component::markChanged()
+	{
+		changeVersion = globalVersion.load(std::memory_order_relaxed);
+	}
+
+	unsigned int Component::nextChangeVersion()
+	{
+		return globalVersion.fetch_add(1, std::memory_order_relaxed);
+	}
 }
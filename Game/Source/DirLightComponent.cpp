@@ -20,4 +20,12 @@ namespace sge
     {
 
     }
+
+    const ComponentReflection& DirLightComponent::getReflection()
+    {
+        static const ComponentReflection reflection = ComponentReflection("DirLightComponent")
+            .field("lightData", &DirLightComponent::lightData);
+
+        return reflection;
+    }
 }
\ No newline at end of file
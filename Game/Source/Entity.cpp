@@ -1,4 +1,5 @@
 #include "Game/Entity.h"
+#include "Game/EntityManager.h"
 #include "Core/Assert.h"
 #include <iostream>
 
@@ -10,4 +11,19 @@ namespace sge
 
 		components.push_back(comp); // Add a component to the entity's component vector
 	}
+
+	void Entity::detachComponent(Component* comp)
+	{
+		components.erase(std::remove(components.begin(), components.end(), comp), components.end());
+	}
+
+	void Entity::setTag(const std::string& tag)
+	{
+		this->tag = tag;
+
+		if (manager)
+		{
+			manager->updateTag(this);
+		}
+	}
 }
\ No newline at end of file
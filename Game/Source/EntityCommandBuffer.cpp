@@ -0,0 +1,121 @@
+#include "Game/EntityCommandBuffer.h"
+#include "Game/EntityManager.h"
+#include "Game/SystemManager.h"
+#include "Core/Assert.h"
+
+#include <algorithm>
+
+namespace sge
+{
+	EntityCommandBuffer::EntityCommandBuffer() : pendingCount(0)
+	{
+	}
+
+	EntityCommandBuffer::PendingEntity EntityCommandBuffer::createEntity()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		PendingEntity entity = { pendingCount++ };
+		Command command = { CREATE, nullptr, entity.index, nullptr, nullptr, nullptr, nullptr, NO_INIT };
+		commands.push_back(command);
+
+		return entity;
+	}
+
+	void EntityCommandBuffer::destroyEntity(Entity* entity)
+	{
+		SGE_ASSERT(entity);
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		Command command = { DESTROY, entity, 0, nullptr, nullptr, nullptr, nullptr, NO_INIT };
+		commands.push_back(command);
+	}
+
+	void EntityCommandBuffer::record(CommandType type, Entity* entity, size_t pending, void* factory, CreateFunction create, InitFunction init)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		SGE_ASSERT(entity || pending < pendingCount);
+
+		Command command = { type, entity, pending, nullptr, factory, create, nullptr, NO_INIT };
+
+		if (init)
+		{
+			command.init = inits.size();
+			inits.push_back(init);
+		}
+
+		commands.push_back(command);
+	}
+
+	void EntityCommandBuffer::playback(EntityManager& entityManager, SystemManager* systemManager)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		// Group the commands by type so each kind of change is applied in one tight loop.
+		std::stable_sort(commands.begin(), commands.end(), [](const Command& lhs, const Command& rhs)
+		{
+			return lhs.type < rhs.type;
+		});
+
+		created.resize(pendingCount);
+
+		for (auto& command : commands)
+		{
+			switch (command.type)
+			{
+			case CREATE:
+			{
+				created[command.pending] = entityManager.createEntity();
+				break;
+			}
+			case ADD:
+			{
+				Entity* entity = command.entity ? command.entity : created[command.pending];
+				Component* component = command.create(command.factory, entity);
+
+				if (command.init != NO_INIT)
+				{
+					inits[command.init](component);
+				}
+
+				if (systemManager)
+				{
+					systemManager->addComponent(component);
+				}
+				break;
+			}
+			case REMOVE:
+			{
+				if (systemManager)
+				{
+					systemManager->removeComponent(command.component);
+				}
+
+				command.destroy(command.factory, command.component);
+				break;
+			}
+			case DESTROY:
+			{
+				entityManager.destroyEntity(command.entity);
+				break;
+			}
+			}
+		}
+
+		commands.clear();
+		inits.clear();
+		created.clear();
+		pendingCount = 0;
+	}
+
+	void EntityCommandBuffer::clear()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		commands.clear();
+		inits.clear();
+		pendingCount = 0;
+	}
+}
@@ -1,12 +1,123 @@
 #include "Game/EntityManager.h"
+#include "Core/Assert.h"
 #include "Core/Memory/PagePoolAllocator.h"
 
+#include <algorithm>
+#include <iterator>
+
 namespace sge
 {
+	namespace
+	{
+		const std::vector<Entity*> noEntities;
+	}
+
+	EntityManager::EntityManager()
+	{
+		// Entities start with the default tag, intern it so it always has the first ID.
+		getTagId(Entity().getTag());
+	}
+
 	Entity* EntityManager::createEntity()
 	{
 		Entity* entity = allocator.create<Entity>();
 		entities.push_back(entity);
+
+		entity->manager = this;
+		entity->tagId = getTagId(entity->tag);
+		entity->tagSlot = tagged[entity->tagId].size();
+		tagged[entity->tagId].push_back(entity);
+
 		return entity;
 	}
+
+	void EntityManager::createEntities(size_t count, std::vector<Entity*>& out)
+	{
+		// No exact reserves, repeated calls would reallocate every time instead of growing geometrically.
+		for (size_t i = 0; i < count; i++)
+		{
+			out.push_back(createEntity());
+		}
+	}
+
+	void EntityManager::destroyEntity(Entity* entity)
+	{
+		// Attached components would be left with a dangling parent.
+		SGE_ASSERT(entity->components.empty());
+
+		// Searching from the back makes destroying the newest entities cheap.
+		auto it = std::find(entities.rbegin(), entities.rend(), entity);
+
+		if (it != entities.rend())
+		{
+			entities.erase(std::next(it).base());
+		}
+
+		if (entity->manager == this)
+		{
+			removeFromTagIndex(entity);
+		}
+
+		allocator.destroy<Entity>(entity);
+	}
+
+	uint32 EntityManager::getTagId(const std::string& tag)
+	{
+		auto it = tagIds.find(tag);
+
+		if (it != tagIds.end())
+		{
+			return it->second;
+		}
+
+		uint32 id = static_cast<uint32>(tagged.size());
+		tagIds.emplace(tag, id);
+		tagged.emplace_back();
+
+		return id;
+	}
+
+	const std::vector<Entity*>& EntityManager::getEntitiesWithTag(uint32 tagId) const
+	{
+		return tagId < tagged.size() ? tagged[tagId] : noEntities;
+	}
+
+	const std::vector<Entity*>& EntityManager::getEntitiesWithTag(const std::string& tag) const
+	{
+		auto it = tagIds.find(tag);
+		return it != tagIds.end() ? tagged[it->second] : noEntities;
+	}
+
+	Entity* EntityManager::findEntityWithTag(const std::string& tag) const
+	{
+		const std::vector<Entity*>& found = getEntitiesWithTag(tag);
+		return found.empty() ? nullptr : found.front();
+	}
+
+	void EntityManager::updateTag(Entity* entity)
+	{
+		uint32 id = getTagId(entity->tag);
+
+		if (id == entity->tagId)
+		{
+			return;
+		}
+
+		removeFromTagIndex(entity);
+
+		entity->tagId = id;
+		entity->tagSlot = tagged[id].size();
+		tagged[id].push_back(entity);
+	}
+
+	void EntityManager::removeFromTagIndex(Entity* entity)
+	{
+		// Swap with the last entity of the tag so removal doesn't shift the rest.
+		std::vector<Entity*>& sameTag = tagged[entity->tagId];
+		Entity* last = sameTag.back();
+
+		sameTag[entity->tagSlot] = last;
+		last->tagSlot = entity->tagSlot;
+		sameTag.pop_back();
+	}
 }
\ No newline at end of file
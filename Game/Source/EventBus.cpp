@@ -0,0 +1,22 @@
+#include "Game/EventBus.h"
+
+#include <atomic>
+
+namespace sge
+{
+	size_t EventBus::nextTypeIndex()
+	{
+		static std::atomic<size_t> counter(0);
+		return counter++;
+	}
+
+	void EventBus::dispatch()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		for (auto& queue : owned)
+		{
+			queue->swap();
+		}
+	}
+}
@@ -3,7 +3,7 @@
 namespace sge
 {
 	EventManager::EventManager(MouseInput* mInput, KeyboardInput* kbInput, GamepadInput* gpInput)
-		: quitState(false), mouseInput(mInput), keyboardInput(kbInput), gamepadInput(gpInput)
+		: quitState(false), keyboardInput(kbInput), mouseInput(mInput), gamepadInput(gpInput), stepCount(0), recorder(nullptr), replay(nullptr)
 	{
 
 	}
@@ -22,63 +22,214 @@ namespace sge
 		return quitState;
 	}
 
+	void EventManager::beginStep(float endTime, bool lastStep)
+	{
+		if (replay)
+		{
+			while (const InputEvent* event = replay->pop(stepCount))
+			{
+				apply(*event);
+			}
+		}
+		else
+		{
+			stepEdges.clear();
+			size_t taken = 0;
+
+			for (; taken < queue.size(); taken++)
+			{
+				InputEvent& event = queue[taken].event;
+
+				if ((queue[taken].time > endTime && !lastStep) || isRepeatedEdge(event))
+				{
+					break;
+				}
+
+				event.step = stepCount;
+
+				if (recorder)
+				{
+					recorder->record(event);
+				}
+
+				apply(event);
+			}
+
+			queue.erase(queue.begin(), queue.begin() + taken);
+		}
+
+		stepCount++;
+	}
+
+	bool EventManager::isRepeatedEdge(const InputEvent& event)
+	{
+		switch (event.type)
+		{
+		case InputEvent::KEY_DOWN:
+		case InputEvent::KEY_UP:
+		case InputEvent::MOUSE_BUTTON_DOWN:
+		case InputEvent::MOUSE_BUTTON_UP:
+		case InputEvent::GAMEPAD_BUTTON_DOWN:
+		case InputEvent::GAMEPAD_BUTTON_UP:
+			break;
+		default:
+			return false;
+		}
+
+		// Down and up of the same device follow each other in the enumeration.
+		uint16 device = event.type & ~1u;
+
+		for (auto& edge : stepEdges)
+		{
+			if ((edge.type & ~1u) == device && edge.code == event.code && edge.x == event.x)
+			{
+				return true;
+			}
+		}
+
+		stepEdges.push_back(event);
+		return false;
+	}
+
 	void EventManager::processInput()
 	{
 		static SDL_Event inputEvent;
 
 		while (SDL_PollEvent(&inputEvent))
 		{
-			switch (inputEvent.type)
+			InputEvent event;
+
+			if (!translate(inputEvent, event))
+			{
+				continue;
+			}
+
+			// Quitting doesn't wait for a step.
+			if (event.type == InputEvent::QUIT)
 			{
-				//Keyboard
-			case SDL_KEYDOWN:
-				keyboardInput->pressKey(inputEvent.key.keysym.scancode);
-				break;
-			case SDL_KEYUP:
-				keyboardInput->releaseKey(inputEvent.key.keysym.scancode);
-				break;
-
-				//Mouse
-			case SDL_MOUSEBUTTONDOWN:
-				mouseInput->pressButton(inputEvent.button.button);
-				break;
-			case SDL_MOUSEBUTTONUP:
-				mouseInput->releaseButton(inputEvent.button.button);
-				break;
-			case SDL_MOUSEMOTION:
-				mouseInput->setMousePosition(inputEvent.motion.x, inputEvent.motion.y);
-				break;
-			case SDL_MOUSEWHEEL:
-				mouseInput->moveMouseWheel(inputEvent.wheel.y);
-				break;
-
-				//Gamepad
-			case SDL_CONTROLLERBUTTONDOWN:
-				gamepadInput->pressButton(inputEvent.cbutton.button, inputEvent.cbutton.which);
-				break;
-			case SDL_CONTROLLERBUTTONUP:
-				gamepadInput->releaseButton(inputEvent.cbutton.button, inputEvent.cbutton.which);
-				break;
-			case SDL_CONTROLLERAXISMOTION:
-				gamepadInput->axisMotion(inputEvent.caxis.axis, inputEvent.caxis.value, inputEvent.caxis.which);
-				break;
-			case SDL_CONTROLLERDEVICEADDED:
-				gamepadInput->addDevice(inputEvent.cdevice.which);
-				break;
-			case SDL_CONTROLLERDEVICEREMOVED:
-				gamepadInput->removeDevice(inputEvent.cdevice.which);
-				break;
-
-				//QUIT
-			case SDL_QUIT:
-				quitState = true;
-				break;
-
-				//WINDOW EVENTS
-			case SDL_WINDOWEVENT:
-				break;
+				if (recorder && !replay)
+				{
+					recorder->record(event);
+				}
+
+				apply(event);
+				continue;
+			}
+
+			// While replaying the log decides the input.
+			if (replay)
+			{
+				continue;
 			}
+
+			QueuedEvent queued = { event, inputEvent.common.timestamp / 1000.0f };
+			queue.push_back(queued);
+		}
+	}
+
+	bool EventManager::translate(const SDL_Event& inputEvent, InputEvent& event)
+	{
+		event.step = stepCount;
+		event.code = 0;
+		event.x = 0;
+		event.y = 0;
+
+		switch (inputEvent.type)
+		{
+			//Keyboard
+		case SDL_KEYDOWN:
+		case SDL_KEYUP:
+			event.type = inputEvent.type == SDL_KEYDOWN ? InputEvent::KEY_DOWN : InputEvent::KEY_UP;
+			event.code = static_cast<uint16>(inputEvent.key.keysym.scancode);
+			return true;
+
+			//Mouse
+		case SDL_MOUSEBUTTONDOWN:
+		case SDL_MOUSEBUTTONUP:
+			event.type = inputEvent.type == SDL_MOUSEBUTTONDOWN ? InputEvent::MOUSE_BUTTON_DOWN : InputEvent::MOUSE_BUTTON_UP;
+			event.code = inputEvent.button.button;
+			return true;
+		case SDL_MOUSEMOTION:
+			event.type = InputEvent::MOUSE_MOTION;
+			event.x = inputEvent.motion.x;
+			event.y = inputEvent.motion.y;
+			return true;
+		case SDL_MOUSEWHEEL:
+			event.type = InputEvent::MOUSE_WHEEL;
+			event.x = inputEvent.wheel.y;
+			return true;
+
+			//Gamepad
+		case SDL_CONTROLLERBUTTONDOWN:
+		case SDL_CONTROLLERBUTTONUP:
+			event.type = inputEvent.type == SDL_CONTROLLERBUTTONDOWN ? InputEvent::GAMEPAD_BUTTON_DOWN : InputEvent::GAMEPAD_BUTTON_UP;
+			event.code = inputEvent.cbutton.button;
+			event.x = inputEvent.cbutton.which;
+			return true;
+		case SDL_CONTROLLERAXISMOTION:
+			event.type = InputEvent::GAMEPAD_AXIS;
+			event.code = inputEvent.caxis.axis;
+			event.x = inputEvent.caxis.value;
+			event.y = inputEvent.caxis.which;
+			return true;
+		case SDL_CONTROLLERDEVICEADDED:
+		case SDL_CONTROLLERDEVICEREMOVED:
+			event.type = inputEvent.type == SDL_CONTROLLERDEVICEADDED ? InputEvent::GAMEPAD_ADDED : InputEvent::GAMEPAD_REMOVED;
+			event.x = inputEvent.cdevice.which;
+			return true;
+
+			//QUIT
+		case SDL_QUIT:
+			event.type = InputEvent::QUIT;
+			return true;
+
+			//WINDOW EVENTS
+		case SDL_WINDOWEVENT:
+		default:
+			return false;
+		}
+	}
+
+	void EventManager::apply(const InputEvent& event)
+	{
+		switch (event.type)
+		{
+		case InputEvent::KEY_DOWN:
+			keyboardInput->pressKey(event.code);
+			break;
+		case InputEvent::KEY_UP:
+			keyboardInput->releaseKey(event.code);
+			break;
+		case InputEvent::MOUSE_BUTTON_DOWN:
+			mouseInput->pressButton(event.code);
+			break;
+		case InputEvent::MOUSE_BUTTON_UP:
+			mouseInput->releaseButton(event.code);
+			break;
+		case InputEvent::MOUSE_MOTION:
+			mouseInput->setMousePosition(event.x, event.y);
+			break;
+		case InputEvent::MOUSE_WHEEL:
+			mouseInput->moveMouseWheel(event.x);
+			break;
+		case InputEvent::GAMEPAD_BUTTON_DOWN:
+			gamepadInput->pressButton(event.code, event.x);
+			break;
+		case InputEvent::GAMEPAD_BUTTON_UP:
+			gamepadInput->releaseButton(event.code, event.x);
+			break;
+		case InputEvent::GAMEPAD_AXIS:
+			gamepadInput->axisMotion(event.code, event.x, event.y);
+			break;
+		case InputEvent::GAMEPAD_ADDED:
+			gamepadInput->addDevice(event.x);
+			break;
+		case InputEvent::GAMEPAD_REMOVED:
+			gamepadInput->removeDevice(event.x);
+			break;
+		case InputEvent::QUIT:
+			quitState = true;
+			break;
 		}
 	}
 }
-		
\ No newline at end of file
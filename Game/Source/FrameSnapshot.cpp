@@ -0,0 +1,140 @@
+#include "Game/FrameSnapshot.h"
+#include "Game/CameraComponent.h"
+#include "Game/Entity.h"
+#include "Game/ModelComponent.h"
+#include "Game/SpriteComponent.h"
+#include "Game/TextComponent.h"
+#include "Game/TransformComponent.h"
+#include "Core/Assert.h"
+
+namespace sge
+{
+	void FrameSnapshot::clear()
+	{
+		cameras.clear();
+		sprites.clear();
+		texts.clear();
+		models.clear();
+		dirLights.clear();
+		pointLights.clear();
+		textData.clear();
+	}
+
+	void FrameSnapshot::addCamera(CameraComponent* camera)
+	{
+		TransformComponent* transform = camera->getComponent<TransformComponent>();
+
+		SGE_ASSERT(transform);
+
+		Camera data;
+		data.viewport = *camera->getViewport();
+		data.viewProj = camera->getViewProj();
+		data.position = transform->getPosition();
+		data.front = transform->getFront();
+		data.renderTarget = camera->getRenderTarget();
+		data.layerMask = camera->getLayerMask();
+
+		cameras.push_back(data);
+	}
+
+	void FrameSnapshot::addCameras(size_t count, Entity* cameras[])
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			CameraComponent* camera = cameras[i]->getComponent<CameraComponent>();
+
+			SGE_ASSERT(camera);
+
+			addCamera(camera);
+		}
+	}
+
+	void FrameSnapshot::addSprites(size_t count, Entity* sprites[])
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			SpriteComponent* sprite = sprites[i]->getComponent<SpriteComponent>();
+
+			SGE_ASSERT(sprite);
+
+			Sprite data;
+			data.matrix = sprite->transform->getMatrix();
+			data.position = sprite->transform->getPosition();
+			data.color = sprite->getColor();
+			data.texture = sprite->getTexture();
+			data.pipeline = sprite->getPipeline();
+			data.layer = sprite->getLayer();
+			data.frustumCulling = sprite->hasFrustumCulling();
+
+			this->sprites.push_back(data);
+		}
+	}
+
+	void FrameSnapshot::addTexts(size_t count, Entity* texts[])
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			TextComponent* text = texts[i]->getComponent<TextComponent>();
+
+			SGE_ASSERT(text);
+
+			const std::string& string = text->getText();
+
+			Text data;
+			data.matrix = text->transform->getMatrix();
+			data.position = text->transform->getPosition();
+			data.scale = text->transform->getScale();
+			data.color = text->getColor();
+			data.font = text->getFont();
+			data.layer = text->getLayer();
+			data.textOffset = static_cast<uint32>(textData.size());
+			data.textLength = static_cast<uint32>(string.size());
+
+			textData.insert(textData.end(), string.begin(), string.end());
+			this->texts.push_back(data);
+		}
+	}
+
+	void FrameSnapshot::addModels(size_t count, Entity* models[])
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			ModelComponent* model = models[i]->getComponent<ModelComponent>();
+
+			SGE_ASSERT(model);
+
+			Model data;
+			data.matrix = model->transform->getMatrix();
+			data.position = model->transform->getPosition();
+			data.modelResource = model->getModelResource();
+			data.pipeline = model->getPipeline();
+			data.cubeMap = model->getCubeMap();
+			data.shininess = model->getShininess();
+			data.glossyness = model->getGlossyness();
+			data.layer = model->getLayer();
+			data.frustumCulling = model->hasFrustumCulling();
+
+			this->models.push_back(data);
+		}
+	}
+
+	void FrameSnapshot::addLights(size_t count, Entity* lights[])
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			DirLightComponent* dirLight = lights[i]->getComponent<DirLightComponent>();
+
+			if (dirLight)
+			{
+				dirLights.push_back(dirLight->getLightData());
+			}
+
+			PointLightComponent* pointLight = lights[i]->getComponent<PointLightComponent>();
+
+			if (pointLight)
+			{
+				pointLights.push_back(pointLight->getLightData());
+			}
+		}
+	}
+}
@@ -0,0 +1,214 @@
+#include "Game/GlyphAtlas.h"
+
+#include "Renderer/GraphicsDevice.h"
+#include "Resources/FontResource.h"
+
+#include <cstring>
+
+namespace sge
+{
+	namespace
+	{
+		// Empty pixels around each glyph, so filtering and mipmaps don't bleed in the neighbours.
+		const size_t PADDING = 1;
+	}
+
+	GlyphAtlas::GlyphAtlas(GraphicsDevice* device, Font* font, size_t pageSize, size_t maxPages) :
+		device(device),
+		font(font),
+		pageSize(pageSize),
+		maxPages(maxPages),
+		stringStamp(0)
+	{
+	}
+
+	GlyphAtlas::~GlyphAtlas()
+	{
+		for (auto& page : pages)
+		{
+			if (page.texture)
+			{
+				device->deleteTexture(page.texture);
+			}
+		}
+	}
+
+	void GlyphAtlas::beginString()
+	{
+		stringStamp++;
+	}
+
+	void GlyphAtlas::endString()
+	{
+		for (auto& page : pages)
+		{
+			if (page.dirty && page.texture)
+			{
+				device->generateMipmaps(page.texture);
+			}
+
+			page.dirty = false;
+		}
+	}
+
+	const GlyphAtlas::Glyph* GlyphAtlas::getGlyph(uint32 charCode)
+	{
+		auto it = glyphs.find(charCode);
+
+		if (it != glyphs.end())
+		{
+			pages[it->second.page].lastUsed = stringStamp;
+
+			return &it->second;
+		}
+
+		FT_Load_Char(font->face, charCode, FT_LOAD_RENDER);
+		FT_GlyphSlot slot = font->face->glyph;
+
+		size_t width = slot->bitmap.width;
+		size_t height = slot->bitmap.rows;
+
+		if (width + PADDING > pageSize || height + PADDING > pageSize)
+		{
+			return nullptr;
+		}
+
+		size_t page = 0;
+		size_t x = 0;
+		size_t y = 0;
+
+		while (page < pages.size() && !allocate(pages[page], width, height, x, y))
+		{
+			page++;
+		}
+
+		if (page == pages.size())
+		{
+			if (pages.size() >= maxPages)
+			{
+				page = evict();
+			}
+
+			// Every page holds glyphs of the current string, a new page goes over the limit.
+			if (page == pages.size())
+			{
+				Page newPage;
+				newPage.texture = device->createTextTexture(pageSize, pageSize, nullptr);
+				newPage.bottom = 0;
+				newPage.dirty = false;
+				pages.push_back(newPage);
+			}
+
+			allocate(pages[page], width, height, x, y);
+		}
+
+		pages[page].lastUsed = stringStamp;
+
+		if (width > 0 && height > 0 && pages[page].texture)
+		{
+			const unsigned char* source = slot->bitmap.buffer;
+
+			if (slot->bitmap.pitch != static_cast<int>(width))
+			{
+				pixels.resize(width * height);
+
+				for (size_t row = 0; row < height; row++)
+				{
+					std::memcpy(&pixels[row * width], slot->bitmap.buffer + row * slot->bitmap.pitch, width);
+				}
+
+				source = pixels.data();
+			}
+
+			device->copyTextTextureData(pages[page].texture, x, y, width, height, source);
+			pages[page].dirty = true;
+		}
+
+		Glyph& glyph = glyphs[charCode];
+		glyph.page = page;
+		glyph.size = math::vec2(width, height);
+		glyph.uvMin = math::vec2(x, y) / static_cast<float>(pageSize);
+		glyph.uvMax = math::vec2(x + width, y + height) / static_cast<float>(pageSize);
+		glyph.horiBearing = math::vec2(slot->metrics.horiBearingX, slot->metrics.horiBearingY);
+		glyph.vertBearing = math::vec2(slot->metrics.vertBearingX, slot->metrics.vertBearingY);
+		glyph.metrics = math::vec2(slot->metrics.width, slot->metrics.height);
+		glyph.advance = math::vec2(slot->advance.x / 32, slot->advance.y / 32);
+
+		return &glyph;
+	}
+
+	bool GlyphAtlas::allocate(Page& page, size_t width, size_t height, size_t& x, size_t& y)
+	{
+		width += PADDING;
+		height += PADDING;
+
+		for (auto& shelf : page.shelves)
+		{
+			if (height <= shelf.height && shelf.x + width <= pageSize)
+			{
+				x = shelf.x;
+				y = shelf.y;
+				shelf.x += width;
+
+				return true;
+			}
+		}
+
+		if (page.bottom + height > pageSize)
+		{
+			return false;
+		}
+
+		Shelf shelf = { page.bottom, height, width };
+		page.shelves.push_back(shelf);
+		page.bottom += height;
+
+		x = 0;
+		y = shelf.y;
+
+		return true;
+	}
+
+	size_t GlyphAtlas::evict()
+	{
+		size_t oldest = pages.size();
+
+		for (size_t i = 0; i < pages.size(); i++)
+		{
+			if (pages[i].lastUsed != stringStamp && (oldest == pages.size() || pages[i].lastUsed < pages[oldest].lastUsed))
+			{
+				oldest = i;
+			}
+		}
+
+		if (oldest == pages.size())
+		{
+			return oldest;
+		}
+
+		for (auto it = glyphs.begin(); it != glyphs.end();)
+		{
+			if (it->second.page == oldest)
+			{
+				it = glyphs.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		pages[oldest].shelves.clear();
+		pages[oldest].bottom = 0;
+
+		// The old glyphs would show in the padding and the free space around the new ones.
+		if (pages[oldest].texture)
+		{
+			pixels.assign(pageSize * pageSize, 0);
+			device->copyTextTextureData(pages[oldest].texture, 0, 0, pageSize, pageSize, pixels.data());
+			pages[oldest].dirty = true;
+		}
+
+		return oldest;
+	}
+}
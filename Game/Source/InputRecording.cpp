@@ -0,0 +1,98 @@
+#include "Game/InputRecording.h"
+#include "Core/Random.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace sge
+{
+	namespace
+	{
+		const char MAGIC[4] = { 'S', 'G', 'E', 'I' };
+		const uint32 VERSION = 1;
+
+		struct FileHeader
+		{
+			char magic[4];
+			uint32 version;
+			uint32 seed;
+			uint32 eventCount;
+		};
+	}
+
+	void InputRecorder::start(uint32 seed)
+	{
+		this->seed = seed;
+		events.clear();
+
+		setSeed(seed);
+	}
+
+	bool InputRecorder::save(const std::string& path) const
+	{
+		FILE* file = std::fopen(path.c_str(), "wb");
+
+		if (file == nullptr)
+		{
+			return false;
+		}
+
+		FileHeader header;
+		std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.version = VERSION;
+		header.seed = seed;
+		header.eventCount = static_cast<uint32>(events.size());
+
+		bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+			std::fwrite(events.data(), sizeof(InputEvent), events.size(), file) == events.size();
+
+		return std::fclose(file) == 0 && written;
+	}
+
+	bool InputReplay::load(const std::string& path)
+	{
+		events.clear();
+		next = 0;
+
+		FILE* file = std::fopen(path.c_str(), "rb");
+
+		if (file == nullptr)
+		{
+			return false;
+		}
+
+		FileHeader header;
+		bool valid = std::fread(&header, sizeof(header), 1, file) == 1 &&
+			std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION;
+
+		// The event count comes from the file, it has to fit in the bytes left before anything is allocated.
+		if (valid)
+		{
+			long start = std::ftell(file);
+			valid = start >= 0 && std::fseek(file, 0, SEEK_END) == 0;
+
+			long end = valid ? std::ftell(file) : -1;
+			valid = valid && end >= start && std::fseek(file, start, SEEK_SET) == 0 &&
+				static_cast<uint64>(header.eventCount) * sizeof(InputEvent) <= static_cast<uint64>(end - start);
+		}
+
+		if (valid)
+		{
+			events.resize(header.eventCount);
+			valid = std::fread(events.data(), sizeof(InputEvent), events.size(), file) == events.size();
+		}
+
+		std::fclose(file);
+
+		if (!valid)
+		{
+			events.clear();
+			return false;
+		}
+
+		seed = header.seed;
+		setSeed(seed);
+
+		return true;
+	}
+}
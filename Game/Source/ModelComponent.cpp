@@ -18,13 +18,6 @@ namespace sge
 	{
 	}
 
-	void ModelComponent::render(GraphicsDevice* device)
-	{
-        SGE_ASSERT(renderer);
-
-		renderer->renderModel(this);
-	}
-
 	void ModelComponent::setModelResource(sge::Handle <sge::ModelResource>* modelHandle)
 	{
 		this->modelHandle = modelHandle;
@@ -5,7 +5,9 @@
 
 namespace sge
 {
-	PhysicsComponent::PhysicsComponent(Entity* ent) : Component(ent)
+	PhysicsComponent::PhysicsComponent(Entity* ent) : Component(ent),
+		body(nullptr),
+		shape(nullptr)
 	{	
 	}
 
@@ -40,6 +42,7 @@ namespace sge
 		shape->calculateLocalInertia(mass, fallInertia);
 		btRigidBody::btRigidBodyConstructionInfo consInfo(mass, motiState, shape, fallInertia);
 		body = new btRigidBody(consInfo);
+		body->setUserPointer(getParent()); // Lets collision events name the entity.
 		return body;
 	}
 }
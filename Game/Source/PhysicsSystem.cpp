@@ -1,4 +1,7 @@
 #include "Game/PhysicsSystem.h"
+#include "Game/TransformComponent.h"
+
+#include <algorithm>
 
 namespace sge
 {
@@ -11,6 +14,9 @@ namespace sge
 
 
 		dynamicsWorld = new btDiscreteDynamicsWorld(dispatcher, broadphase, solver, collisionConfiguration);
+
+		readsComponent<PhysicsComponent>();
+		writesComponent<TransformComponent>();
 	}
 
 
@@ -48,6 +54,56 @@ namespace sge
 	void PhysicsSystem::stepWorld(float dt)
 	{
 		dynamicsWorld->stepSimulation(dt, 10);
+
+		if (getEventBus())
+		{
+			publishContacts();
+		}
+	}
+
+	void PhysicsSystem::publishContacts()
+	{
+		contacts.clear();
+
+		for (int i = 0; i < dispatcher->getNumManifolds(); i++)
+		{
+			btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(i);
+
+			if (manifold->getNumContacts() == 0)
+			{
+				continue;
+			}
+
+			const btManifoldPoint* deepest = &manifold->getContactPoint(0);
+			float impulse = 0.0f;
+
+			for (int j = 0; j < manifold->getNumContacts(); j++)
+			{
+				const btManifoldPoint& point = manifold->getContactPoint(j);
+				impulse += point.getAppliedImpulse();
+
+				if (point.getDistance() < deepest->getDistance())
+				{
+					deepest = &point;
+				}
+			}
+
+			const btVector3& position = deepest->getPositionWorldOnB();
+			const btVector3& normal = deepest->m_normalWorldOnB;
+
+			CollisionEvent contact =
+			{
+				static_cast<Entity*>(manifold->getBody0()->getUserPointer()),
+				static_cast<Entity*>(manifold->getBody1()->getUserPointer()),
+				math::vec3(position.getX(), position.getY(), position.getZ()),
+				math::vec3(normal.getX(), normal.getY(), normal.getZ()),
+				impulse
+			};
+
+			contacts.push_back(contact);
+		}
+
+		getEventBus()->publish(contacts.data(), contacts.size());
 	}
 
 	PhysicsComponent* PhysicsSystem::createPhysicsComponent(Entity* ent)
@@ -60,4 +116,19 @@ namespace sge
 	{
 		comps.push_back(dynamic_cast<PhysicsComponent*>(comp));
 	}
+
+	void PhysicsSystem::removeComponent(Component* comp)
+	{
+		PhysicsComponent* physComp = dynamic_cast<PhysicsComponent*>(comp);
+		btRigidBody* body = physComp->getBody<btRigidBody>();
+
+		if (body)
+		{
+			dynamicsWorld->removeRigidBody(body);
+			delete body->getMotionState();
+			delete body;
+		}
+
+		comps.erase(std::remove(comps.begin(), comps.end(), physComp), comps.end());
+	}
 }
\ No newline at end of file
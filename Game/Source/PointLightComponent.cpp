@@ -4,7 +4,8 @@
 namespace sge
 {
     PointLightComponent::PointLightComponent(Entity* entity) :
-        LightComponent(entity)
+        LightComponent(entity),
+        positionVersion(0)
     {
     }
 
@@ -15,6 +16,23 @@ namespace sge
 
     void PointLightComponent::update()
     {
-        lightData.position = math::vec4(transform->getPosition(), 1.0f);
+        math::vec3 position = transform->getWorldPosition();
+
+        if (!transform->hasChangedSince(positionVersion))
+        {
+            return;
+        }
+
+        positionVersion = Component::nextChangeVersion();
+        lightData.position = math::vec4(position, 1.0f);
+        markChanged();
+    }
+
+    const ComponentReflection& PointLightComponent::getReflection()
+    {
+        static const ComponentReflection reflection = ComponentReflection("PointLightComponent")
+            .field("lightData", &PointLightComponent::lightData);
+
+        return reflection;
     }
 }
\ No newline at end of file
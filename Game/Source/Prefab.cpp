@@ -0,0 +1,75 @@
+#include "Game/Prefab.h"
+#include "Game/EntityManager.h"
+#include "Game/SystemManager.h"
+#include "Game/TransformComponent.h"
+
+namespace sge
+{
+	Prefab::~Prefab()
+	{
+		// Reverse order, components may refer to the ones added before them.
+		for (auto it = entries.rbegin(); it != entries.rend(); ++it)
+		{
+			prototypeEntity.detachComponent(it->prototype);
+			delete it->prototype;
+		}
+	}
+
+	std::vector<Entity*> Prefab::instantiate(EntityManager& entityManager, size_t count, const PrefabTransform* transforms, SystemManager* systemManager)
+	{
+		std::vector<Entity*> entities;
+		entityManager.createEntities(count, entities);
+
+		if (prototypeEntity.getTag() != Entity().getTag())
+		{
+			for (auto entity : entities)
+			{
+				entity->setTag(prototypeEntity.getTag());
+			}
+		}
+
+		std::vector<Component*> created;
+		created.reserve(count * entries.size());
+
+		for (auto& entry : entries)
+		{
+			entry.instantiate(entities.data(), count, created);
+		}
+
+		if (transforms)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				TransformComponent* transform = entities[i]->getComponent<TransformComponent>();
+
+				if (transform)
+				{
+					const PrefabTransform& placement = transforms[i];
+
+					transform->setPosition(placement.position);
+
+					if (placement.overrides & PrefabTransform::SCALE)
+					{
+						transform->setScale(placement.scale);
+					}
+
+					if (placement.overrides & PrefabTransform::ROTATION)
+					{
+						transform->setRotationVector(placement.rotationVector);
+						transform->setAngle(placement.angle);
+					}
+				}
+			}
+		}
+
+		if (systemManager)
+		{
+			for (auto component : created)
+			{
+				systemManager->addComponent(component);
+			}
+		}
+
+		return entities;
+	}
+}
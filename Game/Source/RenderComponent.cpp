@@ -2,12 +2,12 @@
 
 namespace sge
 {
-	RenderComponent::RenderComponent(Entity* ent) : Component(ent)
+	RenderComponent::RenderComponent(Entity* ent) :
+		Component(ent),
+		renderer(nullptr),
+		layer(0),
+		frustumCulling(true)
 	{
-		// TODO do a proper calculation for depth, pipeline etc.
-		// Maybe in the derived classes?
-		// Needs more planning!
-		key.bits = 0;
 	}
 
 	RenderComponent::~RenderComponent()
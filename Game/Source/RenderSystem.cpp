@@ -1,10 +1,12 @@
 #include "Renderer/Buffer.h"
 #include "Renderer/GraphicsDevice.h"
+#include "Renderer/NullGraphicsDevice.h"
 #include "Renderer/RenderData.h"
 #include "Renderer/RenderTarget.h"
 #include "Renderer/VertexLayout.h"
 #include "Renderer/Window.h"
 
+#include "Resources/FontResource.h"
 #include "Resources/ResourceManager.h"
 #include "Resources/ShaderResource.h"
 
@@ -12,6 +14,7 @@
 #include "Game/Entity.h"
 
 #include "Game/CameraComponent.h"
+#include "Game/GlyphAtlas.h"
 
 #include "Game/ModelComponent.h"
 #include "Game/RenderComponent.h"
@@ -19,18 +22,38 @@
 #include "Game/TextComponent.h"
 #include "Game/TransformComponent.h"
 
+#include "Core/ThreadPool.h"
+
 #include "Renderer/CubeMap.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 
 namespace sge
 {
     RenderSystem::RenderSystem(Window& window) :
 		queue(1000),
+        pool(nullptr),
+        renderTarget(nullptr),
+        boundTarget(nullptr),
+        lightVersion(0),
+        lightsFromSnapshot(false),
+        snapshot(nullptr),
         initialized(false),
         acceptingCommands(false),
         clearColor(0.5f, 0.6f, 0.2f, 1.0f)
 	{
-		device = new GraphicsDevice(window);
+		// Headless windows have no context to render to.
+		if (window.isHeadless())
+		{
+			device = new NullGraphicsDevice();
+		}
+		else
+		{
+			device = new GraphicsDevice(window);
+		}
 	}
 
     RenderSystem::~RenderSystem()
@@ -56,13 +79,23 @@ namespace sge
     void RenderSystem::deinit()
 	{
         device->deleteShader(sprVertexShader);
-        device->deleteShader(sprPixelShader);
+        device->deleteShader(sprInstanceVertexShader);
+        device->deleteShader(sprInstancePixelShader);
         device->deleteBuffer(sprVertexBuffer);
         device->deleteBuffer(sprVertexUniformBuffer);
         device->deleteBuffer(sprPixelUniformBuffer);
+        device->deleteBuffer(sprInstanceBuffer);
         device->deletePipeline(sprPipeline);
-        device->deleteBuffer(modelVertexUniformBuffer);
-        device->deleteBuffer(modelPixelUniformBuffer);
+        device->deleteBuffer(modelDrawUniformBuffer);
+        device->deleteBuffer(modelFrameUniformBuffer);
+        device->deleteBuffer(modelCameraUniformBuffer);
+        device->deleteBuffer(modelMaterialUniformBuffer);
+
+        for (auto& atlas : glyphAtlases)
+        {
+            delete atlas.second;
+        }
+        glyphAtlases.clear();
 
 		device->deinit();
 
@@ -75,84 +108,292 @@ namespace sge
 
         for (size_t i = 0; i < count; i++)
         {
-            SpriteComponent* sprite = sprites[i]->getComponent <SpriteComponent>();
-
-            SGE_ASSERT(sprite);
+            sprites[i]->getComponent<SpriteComponent>()->setRenderer(this);
+        }
 
-            sprite->setRenderer(this);
+        size_t first = liveFrame.getSprites().size();
+        liveFrame.addSprites(count, sprites);
 
-            for (auto camera : cameras)
-            {
-                uint32 distance = static_cast<uint32>(math::dot(sprite->transform->getPosition(),
-                    camera->getComponent<TransformComponent>()->getPosition() +
-                    camera->getComponent<TransformComponent>()->getFront()));
+        pushSprites(liveFrame, first, count);
+    }
 
-                if (sprite->getColor().a < 1.0f)
-                    sprite->key.fields.depth = UINT32_MAX - distance;
-                else
-                    sprite->key.fields.depth = distance;
+    void RenderSystem::renderTexts(size_t count, Entity* texts[])
+    {
+        SGE_ASSERT(acceptingCommands);
 
-                queue.push(sprite->key, std::bind(&SpriteComponent::render, sprite, std::placeholders::_1));
-            }
+        for (size_t i = 0; i < count; i++)
+        {
+            texts[i]->getComponent<TextComponent>()->setRenderer(this);
         }
+
+        size_t first = liveFrame.getTexts().size();
+        liveFrame.addTexts(count, texts);
+
+        pushTexts(liveFrame, first, count);
     }
 
-    void RenderSystem::renderTexts(size_t count, Entity* texts[])
+    void RenderSystem::renderModels(size_t count, Entity* models[])
     {
         SGE_ASSERT(acceptingCommands);
 
         for (size_t i = 0; i < count; i++)
         {
-            TextComponent* text = texts[i]->getComponent <TextComponent>();
+            models[i]->getComponent<ModelComponent>()->setRenderer(this);
+        }
+
+        size_t first = liveFrame.getModels().size();
+        liveFrame.addModels(count, models);
+
+        pushModels(liveFrame, first, count);
+    }
+
+    void RenderSystem::pushSprites(const FrameSnapshot& frame, size_t first, size_t count)
+    {
+        // The bounds are computed before the views read them in parallel.
+        // The sprite quad spans -1..1 on the x and y axes of its transform.
+        const FrameSnapshot::Sprite* sprites = frame.getSprites().data() + first;
 
-            SGE_ASSERT(text);
+        cullSpheres.resize(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const math::mat4& matrix = sprites[i].matrix;
+            math::vec3 axisX = math::vec3(matrix[0]);
+            math::vec3 axisY = math::vec3(matrix[1]);
+
+            cullSpheres[i].center = math::vec3(matrix[3]);
+            cullSpheres[i].radius = sprites[i].frustumCulling ?
+                math::max(math::length(axisX + axisY), math::length(axisX - axisY)) : INFINITY;
+        }
+
+        cullVisibility.resize(views.size() * count);
+
+        forEachView([&](size_t v)
+        {
+            RenderView& view = views[v];
+            RenderQueue::Segment& segment = queue.getSegment(v);
+            uint8* visible = cullVisibility.data() + v * count;
 
-            text->setRenderer(this);
+            view.frustum.cull(cullSpheres.data(), count, visible);
 
-            for (auto camera : cameras)
+            for (size_t i = 0; i < count; i++)
             {
-                uint32 distance = static_cast<uint32>(math::dot(text->transform->getPosition(),
-                    camera->getComponent<TransformComponent>()->getPosition() +
-                    camera->getComponent<TransformComponent>()->getFront()));
+                const FrameSnapshot::Sprite& sprite = sprites[i];
+
+                if (!drawsLayer(view, sprite.layer))
+                {
+                    continue;
+                }
+
+                if (!visible[i])
+                {
+                    view.cullCounters.culled++;
+                    continue;
+                }
+
+                view.cullCounters.visible++;
+
+                Pipeline* pipeline = sprite.pipeline ? sprite.pipeline : sprPipeline;
+
+                SortKeyFields key = {};
+                key.view = static_cast<uint32>(v);
+                key.layer = sprite.layer;
+                key.translucent = sprite.color.a < 1.0f;
+                key.pipeline = SortKeyEncoder::getId(pipeline);
+                key.texture = SortKeyEncoder::getId(sprite.texture);
+                key.depth = getDepth(view, sprite.position);
+
+                DrawSpritePacket& packet = segment.push<DrawSpritePacket>(keyEncoder.encode(key));
+                packet.pipeline = pipeline;
+                packet.texture = sprite.texture;
+                packet.view = static_cast<uint32>(v);
+                packet.MVP = view.viewProj * sprite.matrix;
+                packet.color = sprite.color;
+            }
+        });
+    }
 
-                if (text->getColor().a < 1.0f)
-                    text->key.fields.depth = UINT32_MAX - distance;
-                else
-                    text->key.fields.depth = distance;
+    void RenderSystem::pushTexts(const FrameSnapshot& frame, size_t first, size_t count)
+    {
+        const FrameSnapshot::Text* texts = frame.getTexts().data() + first;
+        const char* textData = frame.getTextData().data();
+
+        forEachView([&](size_t v)
+        {
+            const RenderView& view = views[v];
+            RenderQueue::Segment& segment = queue.getSegment(v);
 
-                queue.push(text->key, std::bind(&TextComponent::render, text, std::placeholders::_1));
+            for (size_t i = 0; i < count; i++)
+            {
+                const FrameSnapshot::Text& text = texts[i];
+
+                if (!drawsLayer(view, text.layer))
+                {
+                    continue;
+                }
+
+                SortKeyFields key = {};
+                key.view = static_cast<uint32>(v);
+                key.layer = text.layer;
+                key.translucent = text.color.a < 1.0f;
+                key.pipeline = SortKeyEncoder::getId(textPipeline);
+                key.material = SortKeyEncoder::getId(text.font);
+                key.depth = getDepth(view, text.position);
+
+                uint32 textOffset = segment.pushData(textData + text.textOffset, text.textLength);
+
+                DrawTextPacket& packet = segment.push<DrawTextPacket>(keyEncoder.encode(key));
+                packet.font = text.font;
+                packet.textOffset = textOffset;
+                packet.textLength = text.textLength;
+                packet.view = static_cast<uint32>(v);
+                packet.matrix = text.matrix;
+                packet.scale = text.scale;
+                packet.color = text.color;
             }
-        }
+        });
     }
 
-    void RenderSystem::renderModels(size_t count, Entity* models[])
+    void RenderSystem::pushModels(const FrameSnapshot& frame, size_t first, size_t count)
     {
-        SGE_ASSERT(acceptingCommands);
+        // Spheres reject most of the hidden models, the boxes of the ones left are tested after.
+        // All bounds are computed up front, the views only read them.
+        const FrameSnapshot::Model* models = frame.getModels().data() + first;
+
+        cullSpheres.resize(count);
+        cullModelBounds.resize(count);
+        cullMeshBounds.clear();
+        cullMeshOffsets.resize(count + 1);
 
         for (size_t i = 0; i < count; i++)
         {
-            ModelComponent* model = models[i]->getComponent <ModelComponent>();
+            const FrameSnapshot::Model& model = models[i];
+            const math::mat4& matrix = model.matrix;
 
-            SGE_ASSERT(model);
+            cullSpheres[i] = model.modelResource->getBoundingSphere().transform(matrix);
+            cullModelBounds[i] = model.modelResource->getBounds().transform(matrix);
+            cullMeshOffsets[i] = cullMeshBounds.size();
 
-            model->setRenderer(this);
+            if (!model.frustumCulling)
+            {
+                cullSpheres[i].radius = INFINITY;
+            }
 
-            for (auto camera : cameras)
+            for (auto mesh : model.modelResource->getMeshes())
             {
-                //uint32 distance = static_cast<uint32>(math::dot(model->transform->getPosition(),
-                //    camera->getComponent<TransformComponent>()->getPosition() +
-                //    camera->getComponent<TransformComponent>()->getFront()));
+                cullMeshBounds.push_back(mesh->bounds.transform(matrix));
+            }
+        }
+
+        cullMeshOffsets[count] = cullMeshBounds.size();
+        cullVisibility.resize(views.size() * count);
+
+        forEachView([&](size_t v)
+        {
+            RenderView& view = views[v];
+            RenderQueue::Segment& segment = queue.getSegment(v);
+            uint8* visible = cullVisibility.data() + v * count;
 
-                //model->key.fields.depth = distance;
+            view.frustum.cull(cullSpheres.data(), count, visible);
 
-                queue.push(model->key, std::bind(&ModelComponent::render, model, std::placeholders::_1));
+            for (size_t i = 0; i < count; i++)
+            {
+                const FrameSnapshot::Model& model = models[i];
+
+                if (!drawsLayer(view, model.layer))
+                {
+                    continue;
+                }
+
+                bool culled = !visible[i] ||
+                    (model.frustumCulling && !view.frustum.intersects(cullModelBounds[i]));
+
+                if (culled)
+                {
+                    view.cullCounters.culled++;
+                    continue;
+                }
+
+                view.cullCounters.visible++;
+
+                const std::vector<Mesh*>& meshes = model.modelResource->getMeshes();
+                const AABB* meshBounds = cullMeshBounds.data() + cullMeshOffsets[i];
+
+                // Meshes of the same model resource share their materials.
+                SortKeyFields key = {};
+                key.view = static_cast<uint32>(v);
+                key.layer = model.layer;
+                key.pipeline = SortKeyEncoder::getId(model.pipeline);
+                key.material = SortKeyEncoder::getId(model.modelResource);
+                key.depth = getDepth(view, model.position);
+
+                for (size_t m = 0; m < meshes.size(); m++)
+                {
+                    Mesh* mesh = meshes[m];
+
+                    // Meshes of a visible model can still be outside on their own.
+                    if (meshes.size() > 1 && model.frustumCulling && !view.frustum.intersects(meshBounds[m]))
+                    {
+                        continue;
+                    }
+
+                    key.texture = SortKeyEncoder::getId(mesh->diffuseTexture);
+
+                    DrawMeshPacket& packet = segment.push<DrawMeshPacket>(keyEncoder.encode(key));
+                    packet.pipeline = model.pipeline;
+                    packet.vertexBuffer = mesh->getVertexBuffer();
+                    packet.indexBuffer = mesh->getIndexBuffer();
+                    packet.diffuseTexture = mesh->diffuseTexture;
+                    packet.normalTexture = mesh->normalTexture;
+                    packet.specularTexture = mesh->specularTexture;
+                    packet.cubeMap = model.cubeMap;
+                    packet.indexCount = static_cast<uint32>(mesh->indices.size());
+                    packet.indexFormat = mesh->getIndexFormat();
+                    packet.shininess = model.shininess;
+                    packet.glossyness = model.glossyness;
+                    packet.view = static_cast<uint32>(v);
+                    packet.model = model.matrix;
+                }
             }
+        });
+    }
+
+    void RenderSystem::forEachView(const std::function<void(size_t)>& task)
+    {
+        if (pool && views.size() > 1)
+        {
+            pool->dispatch(views.size(), task);
+            return;
+        }
+
+        for (size_t v = 0; v < views.size(); v++)
+        {
+            task(v);
         }
     }
 
+    float RenderSystem::getDepth(const RenderView& view, const math::vec3& position) const
+    {
+        return math::dot(position - view.position, view.front);
+    }
+
+    RenderSystem::CullCounters RenderSystem::getCullCounters() const
+    {
+        CullCounters counters = {};
+
+        for (auto& view : views)
+        {
+            counters.visible += view.cullCounters.visible;
+            counters.culled += view.cullCounters.culled;
+        }
+
+        return counters;
+    }
+
     void RenderSystem::renderLights(size_t count, Entity* lights[])
     {
-        SGE_ASSERT(acceptingCommands);
+        // The lights of a snapshot frame come from the snapshot.
+        SGE_ASSERT(acceptingCommands && snapshot == nullptr);
 
         for (size_t i = 0; i < count; i++)
         {
@@ -183,6 +424,7 @@ namespace sge
     {
         SGE_ASSERT(!acceptingCommands);
 
+        this->renderTarget = renderTarget;
         device->bindRenderTarget(renderTarget);
     }
 
@@ -204,6 +446,63 @@ namespace sge
     {
         SGE_ASSERT(initialized && !acceptingCommands);
 
+        // The entities of the frame are copied to liveFrame as they're rendered.
+        liveFrame.clear();
+
+        for (auto camera : cameras)
+        {
+            liveFrame.addCamera(camera);
+        }
+
+        snapshot = nullptr;
+
+        beginViews(liveFrame.getCameras());
+    }
+
+    void RenderSystem::begin(const FrameSnapshot& snapshot)
+    {
+        SGE_ASSERT(initialized && !acceptingCommands);
+
+        this->snapshot = &snapshot;
+
+        beginViews(snapshot.getCameras());
+
+        pushSprites(snapshot, 0, snapshot.getSprites().size());
+        pushTexts(snapshot, 0, snapshot.getTexts().size());
+        pushModels(snapshot, 0, snapshot.getModels().size());
+    }
+
+    void RenderSystem::beginViews(const std::vector<FrameSnapshot::Camera>& viewCameras)
+    {
+        // render() draws the views in key order, so every view needs its own value in the key.
+        SGE_ASSERT(viewCameras.size() <= (static_cast<size_t>(1) << keyEncoder.getLayout().viewBits));
+
+        views.clear();
+
+        for (auto& camera : viewCameras)
+        {
+            RenderView view;
+            view.viewport = camera.viewport;
+            view.viewProj = camera.viewProj;
+            view.position = camera.position;
+            view.front = camera.front;
+            view.renderTarget = camera.renderTarget;
+            view.layerMask = camera.layerMask;
+            view.frustum = Frustum(view.viewProj);
+            view.cullCounters.visible = 0;
+            view.cullCounters.culled = 0;
+
+            views.push_back(view);
+        }
+
+        // One segment per view, so the views can push at the same time.
+        size_t segmentCount = views.empty() ? 1 : views.size();
+
+        if (queue.getSegmentCount() != segmentCount)
+        {
+            queue.setSegmentCount(segmentCount);
+        }
+
         queue.begin();
 
         acceptingCommands = true;
@@ -213,10 +512,18 @@ namespace sge
 	{
         SGE_ASSERT(acceptingCommands);
 
-        calculateLightData();
+        if (snapshot)
+        {
+            calculateSnapshotLightData();
+        }
+        else
+        {
+            calculateLightData();
+        }
 
 		queue.end();
 
+        snapshot = nullptr;
         acceptingCommands = false;
 	}
 
@@ -224,9 +531,83 @@ namespace sge
     {
         SGE_ASSERT(initialized && !acceptingCommands);
 
-        for (auto& command : queue.getQueue())
+        if (frameUniformsChanged)
+        {
+            device->copyData(modelFrameUniformBuffer, sizeof(modelFrameUniformData), &modelFrameUniformData);
+            frameUniformsChanged = false;
+        }
+
+        const std::vector<RenderQueue::Item>& items = queue.getItems();
+
+        // The views are drawn in order and the segment of an item is its view. Views without
+        // items still clear their target.
+        boundTarget = renderTarget;
+        size_t nextView = 0;
+
+        for (size_t i = 0; i < items.size();)
+        {
+            const RenderQueue::Item& item = items[i];
+
+            while (nextView < views.size() && nextView <= item.segment)
+            {
+                beginViewTarget(views[nextView++]);
+            }
+
+            switch (item.type)
+            {
+            case PacketType::DRAW_SPRITE:
+                // Consumes the following sprites that can be drawn in the same batch.
+                i += drawSprites(&items[i], items.size() - i);
+                continue;
+            case PacketType::DRAW_TEXT:
+            {
+                const DrawTextPacket& packet = queue.getPacket<DrawTextPacket>(item);
+                drawText(packet, queue.getData(item, packet.textOffset));
+                break;
+            }
+            case PacketType::DRAW_MESH:
+                drawMesh(queue.getPacket<DrawMeshPacket>(item));
+                break;
+            }
+
+            i++;
+        }
+
+        while (nextView < views.size())
+        {
+            beginViewTarget(views[nextView++]);
+        }
+
+        // Later draws go to the target set with setRenderTarget again.
+        bindTarget(renderTarget);
+    }
+
+    void RenderSystem::bindTarget(RenderTarget* target)
+    {
+        if (target == boundTarget)
+        {
+            return;
+        }
+
+        if (target)
+        {
+            device->bindRenderTarget(target);
+        }
+        else
+        {
+            device->debindRenderTarget();
+        }
+
+        boundTarget = target;
+    }
+
+    void RenderSystem::beginViewTarget(const RenderView& view)
+    {
+        bindTarget(view.renderTarget ? view.renderTarget : renderTarget);
+
+        if (view.renderTarget)
         {
-            command.second(device);
+            device->clear(clearColor.r, clearColor.g, clearColor.b, clearColor.a);
         }
     }
 
@@ -243,6 +624,7 @@ namespace sge
 
         if (flags & RENDERTARGET)
         {
+            renderTarget = nullptr;
             device->debindRenderTarget();
         }
 
@@ -269,33 +651,19 @@ namespace sge
         }
     }
 
-    void RenderSystem::renderSprite(SpriteComponent* sprite)
+    void RenderSystem::drawSprite(const DrawSpritePacket& packet)
     {
-        static size_t pass = 0;
-
-        SGE_ASSERT(cameras.size() > pass);
-
-        Pipeline* pipeline = sprite->getPipeline();
-        Texture* texture = sprite->getTexture();
-
-        if (texture)
+        if (packet.texture)
         {
-            device->bindTexture(texture, 0);
+            device->bindTexture(packet.texture, 0);
         }
 
-        if (pipeline)
-        {
-            device->bindPipeline(pipeline);
-        }
-        else
-        {
-            device->bindPipeline(sprPipeline);
-        }
+        device->bindPipeline(packet.pipeline);
 
-        device->bindViewport(cameras[pass]->getViewport());
+        device->bindViewport(&views[packet.view].viewport);
 
-        sprVertexUniformData.MVP = cameras[pass]->getViewProj() * sprite->getComponent<TransformComponent>()->getMatrix();
-        sprPixelUniformData.color = sprite->getColor();
+        sprVertexUniformData.MVP = packet.MVP;
+        sprPixelUniformData.color = packet.color;
 
         device->bindVertexUniformBuffer(sprVertexUniformBuffer, 0);
         device->copyData(sprVertexUniformBuffer, sizeof(sprVertexUniformData), &sprVertexUniformData);
@@ -305,105 +673,181 @@ namespace sge
 
         device->draw(6);
 
-        if (texture)
+        if (packet.texture)
         {
-            device->debindTexture(texture, 0);
+            device->debindTexture(packet.texture, 0);
         }
 
-        if (pipeline)
+        device->debindPipeline(packet.pipeline);
+    }
+
+    size_t RenderSystem::drawSprites(const RenderQueue::Item* items, size_t count)
+    {
+        const DrawSpritePacket& first = queue.getPacket<DrawSpritePacket>(items[0]);
+
+        // Custom pipelines have their own shaders, which expect a single sprite.
+        if (first.pipeline != sprPipeline)
         {
-            device->debindPipeline(pipeline);
+            drawSprite(first);
+            return 1;
         }
-        else
+
+        size_t instanceCount = 0;
+
+        while (instanceCount < count && instanceCount < MAX_SPRITE_INSTANCES && items[instanceCount].type == PacketType::DRAW_SPRITE)
         {
-            device->debindPipeline(sprPipeline);
+            const DrawSpritePacket& packet = queue.getPacket<DrawSpritePacket>(items[instanceCount]);
+
+            if (packet.pipeline != first.pipeline || packet.texture != first.texture || packet.view != first.view)
+            {
+                break;
+            }
+
+            sprInstanceData[instanceCount].MVP = packet.MVP;
+            sprInstanceData[instanceCount].color = packet.color;
+            instanceCount++;
+        }
+
+        if (first.texture)
+        {
+            device->bindTexture(first.texture, 0);
         }
 
-        if (++pass >= cameras.size())
-            pass = 0;
+        device->bindPipeline(sprPipeline);
+
+        device->bindViewport(&views[first.view].viewport);
+
+        device->bindVertexUniformBuffer(sprInstanceBuffer, 0);
+        device->copySubData(sprInstanceBuffer, 0, instanceCount * sizeof(SprInstanceData), sprInstanceData);
+
+        device->drawInstanced(6, instanceCount);
+
+        if (first.texture)
+        {
+            device->debindTexture(first.texture, 0);
+        }
+
+        device->debindPipeline(sprPipeline);
+
+        return instanceCount;
     }
 
-    void RenderSystem::renderText(TextComponent* text)
+    void RenderSystem::drawText(const DrawTextPacket& packet, const char* text)
     {
         device->bindPipeline(textPipeline);
+        device->bindVertexBuffer(textVertexBuffer);
 
-        sge::Font* font = text->getFont();
-        FT_GlyphSlot slot = font->face->glyph;
+        sge::Font* font = packet.font;
+        GlyphAtlas* atlas = getGlyphAtlas(font);
+        atlas->beginString();
+
+        // Each quad is offset by the pen in world space and shaped by the text matrix, as if
+        // the quad was transformed by it and then moved, so only the origin and the axes are needed.
+        math::vec3 origin = math::vec3(packet.matrix[3]);
+        math::vec3 axisX = math::vec3(packet.matrix[0]);
+        math::vec3 axisY = math::vec3(packet.matrix[1]);
+
+        // Corners of the two triangles of a glyph quad, with the texcoords as 0 at the min and 1 at the max uv.
+        static const float corners[6][4] = {
+            { -1.0f, 1.0f, 0.0f, 1.0f },
+            { -1.0f, -1.0f, 0.0f, 0.0f },
+            { 1.0f, -1.0f, 1.0f, 0.0f },
+
+            { 1.0f, 1.0f, 1.0f, 1.0f },
+            { -1.0f, 1.0f, 0.0f, 1.0f },
+            { 1.0f, -1.0f, 1.0f, 0.0f },
+        };
 
-        // Updates textures if text has changed since previous rendering
-        if (text->getText() != previousText)
+        // Lay the string out once and sort the glyph quads by the page they're on.
+        for (auto& vertices : textVertices)
         {
-            while (charTextures.size() != 0)
+            vertices.clear();
+        }
+
+        sge::math::vec2 pen = { 0, 0 }; // The position where the character is drawn.
+        for (size_t i = 0; i < packet.textLength; i++)
+        {
+            const GlyphAtlas::Glyph* glyph = atlas->getGlyph(static_cast<unsigned char>(text[i]));
+
+            if (glyph == nullptr)
             {
-                charTextures.erase(charTextures.begin());
-                characters.erase(characters.begin());
+                continue;
             }
 
-			// Goes through all characters, loads them and stores the glyph info and textures needed to render text for later use
-			// in order to make the actual drawing faster and more efficient.
-            for (size_t i = 0; i < text->getText().size(); i++)
+			// Calculates the y position of current character.
+            pen.y = glyph->vertBearing.y / 32 - font->characterSize;
+            if (glyph->metrics.y / 64 - glyph->horiBearing.y / 64 > 0)
             {
-                FT_Load_Char(font->face, text->getText()[i], FT_LOAD_RENDER);
+                pen.y += glyph->metrics.y / 64 - glyph->horiBearing.y / 64;
+            }
 
-                sge::Texture* texture = device->createTextTexture(slot->bitmap.width, slot->bitmap.rows, slot->bitmap.buffer);
+            if (textVertices.size() <= glyph->page)
+            {
+                textVertices.resize(glyph->page + 1);
+            }
 
-                Character character;
-                character.size = sge::math::vec2(slot->bitmap.width, slot->bitmap.rows);
-                character.horiBearing = sge::math::vec2(slot->metrics.horiBearingX, slot->metrics.horiBearingY);
-                character.vertBearing = sge::math::vec2(slot->metrics.vertBearingX, slot->metrics.vertBearingY);
-                character.metrics = sge::math::vec2(slot->metrics.width, slot->metrics.height);
-				character.advance = sge::math::vec2(slot->advance.x / 32, slot->advance.y / 32);
-                characters.push_back(character);
+            std::vector<float>& vertices = textVertices[glyph->page];
 
-                charTextures.push_back(texture);
+            math::vec3 center = math::vec3(pen.x, pen.y, 0.0f) + origin;
+            math::vec3 halfX = axisX * glyph->size.x;
+            math::vec3 halfY = axisY * glyph->size.y;
+
+            for (auto& corner : corners)
+            {
+                math::vec3 position = center + halfX * corner[0] + halfY * corner[1];
+
+                vertices.push_back(position.x);
+                vertices.push_back(position.y);
+                vertices.push_back(position.z);
+                vertices.push_back(math::mix(glyph->uvMin.x, glyph->uvMax.x, corner[2]));
+                vertices.push_back(math::mix(glyph->uvMin.y, glyph->uvMax.y, corner[3]));
             }
-            previousText = text->getText();
+
+			// Calculates the x position of the next character.
+			pen.x += packet.scale.x * glyph->advance.x;
         }
 
-        // TODO added support for multiple cameras.
-        static size_t pass = 0;
+        atlas->endString();
 
-        SGE_ASSERT(cameras.size() > pass);
+        const RenderView& view = views[packet.view];
 
-        // Render text
-        sge::math::vec2 pen = { 0, 0 }; // The position where the character is drawn.
-        sge::math::vec3 originalPosition = text->getParent()->getComponent<TransformComponent>()->getPosition();
-        sge::math::vec3 originalScale = text->getParent()->getComponent<TransformComponent>()->getScale();
-        for (size_t i = 0; i < text->getText().size(); i++)
+        device->bindViewport(&view.viewport);
+
+        sprVertexUniformData.MVP = view.viewProj;
+        sprPixelUniformData.color = packet.color;
+
+        device->bindVertexUniformBuffer(sprVertexUniformBuffer, 0);
+        device->copyData(sprVertexUniformBuffer, sizeof(sprVertexUniformData), &sprVertexUniformData);
+        device->bindPixelUniformBuffer(sprPixelUniformBuffer, 1);
+        device->copyData(sprPixelUniformBuffer, sizeof(sprPixelUniformData), &sprPixelUniformData);
+
+        // One draw per atlas page, usually the whole string is on one page.
+        for (size_t page = 0; page < textVertices.size(); page++)
         {
-            sge::Texture* texture = charTextures[i];
+            const std::vector<float>& vertices = textVertices[page];
 
-            if (texture)
+            if (vertices.empty())
             {
-                device->bindTexture(texture, 0);
+                continue;
             }
 
-			// Calculates the y position of current character.
-            pen.y = characters[i].vertBearing.y / 32 - font->characterSize;
-            if (characters[i].metrics.y / 64 - characters[i].horiBearing.y / 64 > 0)
+            sge::Texture* texture = atlas->getPageTexture(page);
+
+            if (texture)
             {
-                pen.y += characters[i].metrics.y / 64 - characters[i].horiBearing.y / 64;
+                device->bindTexture(texture, 0);
             }
 
-			// Places the character in its desired position.
-            text->getComponent<TransformComponent>()->setPosition(originalPosition + glm::vec3(pen.x, pen.y, 0));
-            text->getComponent<TransformComponent>()->setScale(originalScale * sge::math::vec3(characters[i].size.x, characters[i].size.y, 1));
-
-            device->bindViewport(cameras[pass]->getViewport());
-
-            sprVertexUniformData.MVP = cameras[pass]->getViewProj() * text->getComponent<TransformComponent>()->getMatrix();
-			sge::math::mat4 testi = text->getComponent<TransformComponent>()->getMatrix();
-            sprPixelUniformData.color = text->getColor();
+            // Strings longer than the vertex buffer are drawn in parts.
+            const size_t chunkSize = MAX_TEXT_GLYPHS * 6 * TEXT_VERTEX_FLOATS;
 
-			// Calculates the x position of the next character.
-			pen.x += originalScale.x * characters[i].advance.x;
-
-            device->bindVertexUniformBuffer(sprVertexUniformBuffer, 0);
-            device->copyData(sprVertexUniformBuffer, sizeof(sprVertexUniformData), &sprVertexUniformData);
-            device->bindPixelUniformBuffer(sprPixelUniformBuffer, 1);
-            device->copyData(sprPixelUniformBuffer, sizeof(sprPixelUniformData), &sprPixelUniformData);
+            for (size_t offset = 0; offset < vertices.size(); offset += chunkSize)
+            {
+                size_t size = std::min(chunkSize, vertices.size() - offset);
 
-            device->draw(6);
+                device->copyData(textVertexBuffer, size * sizeof(float), &vertices[offset]);
+                device->draw(size / TEXT_VERTEX_FLOATS);
+            }
 
             if (texture)
             {
@@ -411,109 +855,126 @@ namespace sge
             }
         }
 
-        text->getComponent<TransformComponent>()->setPosition(originalPosition);
-        text->getComponent<TransformComponent>()->setScale(originalScale);
         device->debindPipeline(textPipeline);
+    }
+
+    GlyphAtlas* RenderSystem::getGlyphAtlas(Font* font)
+    {
+        // The size is part of the key, FontResource::setCharacterSize changes the face in place.
+        FT_Size_Metrics& metrics = font->face->size->metrics;
+        std::pair<const void*, uint32> key(font->face, (static_cast<uint32>(metrics.x_ppem) << 16) | metrics.y_ppem);
 
-        if (++pass >= cameras.size())
-            pass = 0;
+        GlyphAtlas*& atlas = glyphAtlases[key];
+
+        if (atlas == nullptr)
+        {
+            atlas = new GlyphAtlas(device, font);
+        }
+
+        return atlas;
     }
 
-    void RenderSystem::renderModel(ModelComponent* model)
+    void RenderSystem::drawMesh(const DrawMeshPacket& packet)
     {
-        static size_t pass = 0;
+        const RenderView& view = views[packet.view];
+
+		// Per draw data is written straight to the stream buffer.
+		size_t offset = 0;
+		ModelDrawUniformData* drawData = static_cast<ModelDrawUniformData*>(
+			device->allocateStreamData(modelDrawUniformBuffer, sizeof(ModelDrawUniformData), offset));
+
+		// No stream buffer on a NullGraphicsDevice.
+		if (drawData == nullptr)
+		{
+			return;
+		}
+
+		drawData->PV = view.viewProj;
+		drawData->M = packet.model;
+		drawData->shininess = packet.shininess;
+
+        device->bindViewport(&view.viewport);
+
+        device->bindPipeline(packet.pipeline);
+
+		device->bindIndexBuffer(packet.indexBuffer, packet.indexFormat);
+		device->bindVertexBuffer(packet.vertexBuffer);
+
+		device->bindVertexUniformBuffer(modelDrawUniformBuffer, 0, offset, sizeof(ModelDrawUniformData));
+
+		// Uploaded by render().
+		device->bindPixelUniformBuffer(modelFrameUniformBuffer, 1);
+
+		math::vec4 cameraPosition = math::vec4(view.position, 1.0f);
 
-        SGE_ASSERT(cameras.size() > pass);
+		if (!cameraUniformsValid || modelCameraUniformData.CamPos != cameraPosition)
+		{
+			modelCameraUniformData.CamPos = cameraPosition;
+			device->copyData(modelCameraUniformBuffer, sizeof(modelCameraUniformData), &modelCameraUniformData);
+			cameraUniformsValid = true;
+		}
+
+		device->bindPixelUniformBuffer(modelCameraUniformBuffer, 2);
 
-        device->bindViewport(cameras[pass]->getViewport());
+		ModelMaterialUniformData material = {};
+		material.glossyness = packet.glossyness;
 
-        modelVertexUniformData.M = model->getComponent<TransformComponent>()->getMatrix();
-        modelVertexUniformData.PV = cameras[pass]->getViewProj();
-		modelVertexUniformData.shininess = model->getComponent<ModelComponent>()->getShininess();
-        modelPixelUniformData.CamPos = math::vec4(cameras[pass]->getComponent<TransformComponent>()->getPosition(), 1.0f);
+		if (packet.diffuseTexture)
+		{
+			device->bindTexture(packet.diffuseTexture, 0);
+			material.hasDiffuseTex = 1;
+		}
+
+		if (packet.normalTexture)
+		{
+			device->bindTexture(packet.normalTexture, 1);
+			material.hasNormalTex = 1;
+		}
+
+		if (packet.specularTexture)
+		{
+			device->bindTexture(packet.specularTexture, 2);
+			material.hasSpecularTex = 1;
+		}
+
+		if (packet.cubeMap)
+		{
+			device->bindCubeMap(packet.cubeMap, 3);
+			material.hasCubeTex = 1;
+		}
+
+		if (!materialUniformsValid || std::memcmp(&material, &modelMaterialUniformData, sizeof(material)) != 0)
+		{
+			modelMaterialUniformData = material;
+			device->copyData(modelMaterialUniformBuffer, sizeof(modelMaterialUniformData), &modelMaterialUniformData);
+			materialUniformsValid = true;
+		}
+
+		device->bindPixelUniformBuffer(modelMaterialUniformBuffer, 3);
+
+		device->drawIndexed(packet.indexCount);
+
+		if (packet.diffuseTexture)
+		{
+			device->debindTexture(packet.diffuseTexture, 0);
+		}
+
+		if (packet.normalTexture)
+		{
+			device->debindTexture(packet.normalTexture, 1);
+		}
 
-        device->bindPipeline(model->getPipeline());
+		if (packet.specularTexture)
+		{
+			device->debindTexture(packet.specularTexture, 2);
+		}
 
-		for (size_t i = 0; i < model->getModelResource()->getMeshes().size(); i++)
+		if (packet.cubeMap)
 		{
-			device->bindIndexBuffer(model->getModelResource()->getMeshes()[i]->getIndexBuffer());
-			device->bindVertexBuffer(model->getModelResource()->getMeshes()[i]->getVertexBuffer());
-
-			device->bindVertexUniformBuffer(modelVertexUniformBuffer, 0);
-			device->copyData(modelVertexUniformBuffer, sizeof(modelVertexUniformData), &modelVertexUniformData);
-
-			
-			modelPixelUniformData.hasDiffuseTex = 0;		
-			modelPixelUniformData.hasNormalTex = 0;	
-			modelPixelUniformData.hasSpecularTex = 0;	
-			modelPixelUniformData.hasCubeTex = 0;
-
-			Texture* diff = model->getModelResource()->getMeshes()[i]->diffuseTexture;
-			Texture* norm = model->getModelResource()->getMeshes()[i]->normalTexture;
-			Texture* spec = model->getModelResource()->getMeshes()[i]->specularTexture;
-			CubeMap* cube = model->getCubeMap();
-			if (diff)
-			{
-				device->bindTexture(diff, 0);
-				modelPixelUniformData.hasDiffuseTex = 1;
-			}
-
-			if (norm)
-			{
-				device->bindTexture(norm, 1);
-				modelPixelUniformData.hasNormalTex = 1;
-			}
-
-			if (spec)
-			{
-				device->bindTexture(spec, 2);
-				modelPixelUniformData.hasSpecularTex = 1;
-			}			
-			
-			modelPixelUniformData.glossyness = model->getGlossyness();
-
-			if (cube)
-			{
-				device->bindCubeMap(cube, 3);
-				modelPixelUniformData.hasCubeTex = 1;
-			}			
-
-			device->bindPixelUniformBuffer(modelPixelUniformBuffer, 1);
-			device->copyData(modelPixelUniformBuffer, sizeof(modelPixelUniformData), &modelPixelUniformData);
-
-			device->draw(model->getModelResource()->getMeshes()[i]->vertices.size());
-
-			device->debindCubeMap(cube, 3);
-
-			if (diff)
-			{
-				device->debindTexture(diff, 0);
-				modelPixelUniformData.hasDiffuseTex = 0;
-			}
-
-			if (norm)
-			{
-				device->debindTexture(norm, 1);
-				modelPixelUniformData.hasNormalTex = 0;
-			}
-
-			if (spec)
-			{
-				device->debindTexture(spec, 2);
-				modelPixelUniformData.hasSpecularTex = 0;
-			}
-
-			if (cube)
-			{
-				device->debindCubeMap(cube, 3);
-				modelPixelUniformData.hasCubeTex = 0;
-			}
-		}        
-
-        device->debindPipeline(model->getPipeline());
-
-        if (++pass >= cameras.size())
-            pass = 0;
+			device->debindCubeMap(packet.cubeMap, 3);
+		}
+
+        device->debindPipeline(packet.pipeline);
     }
 
     void RenderSystem::setClearColor(float r, float g, float b, float a)
@@ -531,45 +992,109 @@ namespace sge
 
     void RenderSystem::calculateLightData()
     {
-        modelPixelUniformData.numofpl = (float)pointLights.size();
-        modelPixelUniformData.numofdl = (float)dirLights.size();
-		modelPixelUniformData.numofsl = 0.0f;
-		modelPixelUniformData.pad = 0.0f;
+        // Static lights cost a version check per light instead of a copy.
+        bool changed = lightsFromSnapshot || dirLights != uploadedDirLights || pointLights != uploadedPointLights;
+
+        for (size_t i = 0; i < dirLights.size() && !changed; i++)
+        {
+            changed = dirLights[i]->hasChangedSince(lightVersion);
+        }
+
+        for (size_t i = 0; i < pointLights.size() && !changed; i++)
+        {
+            changed = pointLights[i]->hasChangedSince(lightVersion);
+        }
+
+        lightVersion = Component::nextChangeVersion();
+
+        if (!changed)
+        {
+            return;
+        }
+
+        uploadedDirLights = dirLights;
+        uploadedPointLights = pointLights;
+        lightsFromSnapshot = false;
+        frameUniformsChanged = true;
+
+        modelFrameUniformData.numofpl = (float)pointLights.size();
+        modelFrameUniformData.numofdl = (float)dirLights.size();
+		modelFrameUniformData.numofsl = 0.0f;
+		modelFrameUniformData.pad = 0.0f;
 
         for (size_t i = 0; i < dirLights.size(); i++)
         {
-            modelPixelUniformData.dirLights[i] = dirLights[i]->getLightData();
+            modelFrameUniformData.dirLights[i] = dirLights[i]->getLightData();
         }
 
         for (size_t i = 0; i < pointLights.size(); i++)
         {
-            modelPixelUniformData.pointLights[i] = pointLights[i]->getLightData();
+            modelFrameUniformData.pointLights[i] = pointLights[i]->getLightData();
+        }
+    }
+
+    void RenderSystem::calculateSnapshotLightData()
+    {
+        // Snapshot lights are copies without change versions, so they're compared with the uploaded data instead.
+        const std::vector<DirLight>& snapshotDirLights = snapshot->getDirLights();
+        const std::vector<PointLight>& snapshotPointLights = snapshot->getPointLights();
+
+        SGE_ASSERT(snapshotDirLights.size() <= MAX_DIR_LIGHTS && snapshotPointLights.size() <= MAX_POINT_LIGHTS);
+
+        bool changed = !lightsFromSnapshot ||
+            modelFrameUniformData.numofdl != (float)snapshotDirLights.size() ||
+            modelFrameUniformData.numofpl != (float)snapshotPointLights.size() ||
+            std::memcmp(modelFrameUniformData.dirLights, snapshotDirLights.data(), snapshotDirLights.size() * sizeof(DirLight)) != 0 ||
+            std::memcmp(modelFrameUniformData.pointLights, snapshotPointLights.data(), snapshotPointLights.size() * sizeof(PointLight)) != 0;
+
+        if (!changed)
+        {
+            return;
         }
+
+        // The next frame drawn from components has to upload its lights again.
+        uploadedDirLights.clear();
+        uploadedPointLights.clear();
+        lightsFromSnapshot = true;
+        frameUniformsChanged = true;
+
+        modelFrameUniformData.numofpl = (float)snapshotPointLights.size();
+        modelFrameUniformData.numofdl = (float)snapshotDirLights.size();
+        modelFrameUniformData.numofsl = 0.0f;
+        modelFrameUniformData.pad = 0.0f;
+
+        std::copy(snapshotDirLights.begin(), snapshotDirLights.end(), modelFrameUniformData.dirLights);
+        std::copy(snapshotPointLights.begin(), snapshotPointLights.end(), modelFrameUniformData.pointLights);
     }
 
     void RenderSystem::initShaders()
     {
-        Handle<ShaderResource> sprPixelShaderHandle;
         Handle<ShaderResource> sprVertexShaderHandle;
+        Handle<ShaderResource> sprInstanceVertexShaderHandle;
+        Handle<ShaderResource> sprInstancePixelShaderHandle;
         Handle<ShaderResource> textPixelShaderHandle;
 
 
 #ifdef DIRECTX11
         sprVertexShaderHandle = ResourceManager::getMgr().load<ShaderResource>("../Assets/Shaders/SimpleVertexShader.cso");
-        sprPixelShaderHandle = ResourceManager::getMgr().load<ShaderResource>("../Assets/Shaders/SimplePixelShader.cso");
+        sprInstanceVertexShaderHandle = ResourceManager::getMgr().load<ShaderResource>("../Assets/Shaders/SpriteVertexShader.cso");
+        sprInstancePixelShaderHandle = ResourceManager::getMgr().load<ShaderResource>("../Assets/Shaders/SpritePixelShader.cso");
         textPixelShaderHandle = ResourceManager::getMgr().load<ShaderResource>("../Assets/Shaders/SimpleTextPixelShader.cso");
 #elif OPENGL4
         sprVertexShaderHandle = ResourceManager::getMgr().load<ShaderResource>("../Assets/Shaders/SimpleVertexShader.glsl");
-        sprPixelShaderHandle = ResourceManager::getMgr().load<ShaderResource>("../Assets/Shaders/SimplePixelShader.glsl");
+        sprInstanceVertexShaderHandle = ResourceManager::getMgr().load<ShaderResource>("../Assets/Shaders/SpriteVertexShader.glsl");
+        sprInstancePixelShaderHandle = ResourceManager::getMgr().load<ShaderResource>("../Assets/Shaders/SpritePixelShader.glsl");
         textPixelShaderHandle = ResourceManager::getMgr().load<ShaderResource>("../Assets/Shaders/SimpleTextPixelShader.glsl");
 #endif
 
         const std::vector<char>& sprVertexShaderData = sprVertexShaderHandle.getResource<ShaderResource>()->loadShader();
-        const std::vector<char>& sprPixelShaderData = sprPixelShaderHandle.getResource<ShaderResource>()->loadShader();
+        const std::vector<char>& sprInstanceVertexShaderData = sprInstanceVertexShaderHandle.getResource<ShaderResource>()->loadShader();
+        const std::vector<char>& sprInstancePixelShaderData = sprInstancePixelShaderHandle.getResource<ShaderResource>()->loadShader();
         const std::vector<char>& textPixelShaderData = textPixelShaderHandle.getResource<ShaderResource>()->loadShader();
 
         sprVertexShader = device->createShader(sge::ShaderType::VERTEX, sprVertexShaderData.data(), sprVertexShaderData.size());
-        sprPixelShader = device->createShader(sge::ShaderType::PIXEL, sprPixelShaderData.data(), sprPixelShaderData.size());
+        sprInstanceVertexShader = device->createShader(sge::ShaderType::VERTEX, sprInstanceVertexShaderData.data(), sprInstanceVertexShaderData.size());
+        sprInstancePixelShader = device->createShader(sge::ShaderType::PIXEL, sprInstancePixelShaderData.data(), sprInstancePixelShaderData.size());
         textPixelShader = device->createShader(sge::ShaderType::PIXEL, textPixelShaderData.data(), textPixelShaderData.size());
     }
 
@@ -591,10 +1116,14 @@ namespace sge
             1.0f, -1.0f, 0.0f, 1.0f, 1.0f,
         };
 
-        sprPipeline = device->createPipeline(&vertexLayoutDescription, sprVertexShader, sprPixelShader);
+        sprPipeline = device->createPipeline(&vertexLayoutDescription, sprInstanceVertexShader, sprInstancePixelShader);
         sprVertexBuffer = device->createBuffer(sge::BufferType::VERTEX, sge::BufferUsage::DYNAMIC, sizeof(vertexData));
         sprVertexUniformBuffer = device->createBuffer(sge::BufferType::UNIFORM, sge::BufferUsage::DYNAMIC, sizeof(sprVertexUniformData));
         sprPixelUniformBuffer = device->createBuffer(sge::BufferType::UNIFORM, sge::BufferUsage::DYNAMIC, sizeof(sprPixelUniformData));
+        sprInstanceBuffer = device->createBuffer(sge::BufferType::UNIFORM, sge::BufferUsage::DYNAMIC, sizeof(sprInstanceData));
+
+        // Batches only update the instances they use, the buffer always has room for the whole array.
+        device->copyData(sprInstanceBuffer, sizeof(sprInstanceData), nullptr);
 
         device->bindPipeline(sprPipeline);
         device->bindVertexBuffer(sprVertexBuffer);
@@ -610,28 +1139,25 @@ namespace sge
             { 0, 2, sge::VertexSemantic::TEXCOORD }
         } };
 
-        float vertexData[] = {
-            -1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-            -1.0f, -1.0f, 0.0f, 0.0f, 0.0f,
-            1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-
-            1.0f, 1.0f, 0.0f, 1.0f, 1.0f,
-            -1.0f, 1.0f, 0.0f, 0.0f, 1.0f,
-            1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-        };
-
         textPipeline = device->createPipeline(&vertexLayoutDescription, sprVertexShader, textPixelShader);
-        textVertexBuffer = device->createBuffer(sge::BufferType::VERTEX, sge::BufferUsage::DYNAMIC, sizeof(vertexData));
-
-        device->bindPipeline(textPipeline);
-        device->bindVertexBuffer(textVertexBuffer);
-        device->copyData(textVertexBuffer, sizeof(vertexData), vertexData);
-        device->debindPipeline(textPipeline);
+        textVertexBuffer = device->createBuffer(sge::BufferType::VERTEX, sge::BufferUsage::DYNAMIC, MAX_TEXT_GLYPHS * 6 * TEXT_VERTEX_FLOATS * sizeof(float));
     }
 
     void RenderSystem::initModelRendering()
     {
-        modelVertexUniformBuffer = device->createBuffer(BufferType::UNIFORM, BufferUsage::DYNAMIC, sizeof(modelVertexUniformData));
-        modelPixelUniformBuffer = device->createBuffer(BufferType::UNIFORM, BufferUsage::DYNAMIC, sizeof(modelPixelUniformData));
+        modelDrawUniformBuffer = device->createStreamBuffer(MODEL_STREAM_SIZE);
+        modelFrameUniformBuffer = device->createBuffer(BufferType::UNIFORM, BufferUsage::DYNAMIC, sizeof(modelFrameUniformData));
+        modelCameraUniformBuffer = device->createBuffer(BufferType::UNIFORM, BufferUsage::DYNAMIC, sizeof(modelCameraUniformData));
+        modelMaterialUniformBuffer = device->createBuffer(BufferType::UNIFORM, BufferUsage::DYNAMIC, sizeof(modelMaterialUniformData));
+
+        // No lights until calculateLightData sees some.
+        modelFrameUniformData.numofpl = 0.0f;
+        modelFrameUniformData.numofdl = 0.0f;
+        modelFrameUniformData.numofsl = 0.0f;
+        modelFrameUniformData.pad = 0.0f;
+
+        frameUniformsChanged = true;
+        cameraUniformsValid = false;
+        materialUniformsValid = false;
     }
 }
\ No newline at end of file
@@ -1,14 +1,28 @@
 #include "Game/SceneManager.h"
+#include "Core/Assert.h"
 
 namespace sge
 {
-	SceneManager::SceneManager() : newScene(nullptr), sceneAction(NONE)
+	SceneManager::SceneManager(ThreadPool& pool) :
+		sceneAction(NONE),
+		newScene(nullptr),
+		pool(pool),
+		loaded(false),
+		loadingScene(nullptr),
+		loadingAction(NONE)
 	{
 
 	}
 
 	SceneManager::~SceneManager()
 	{
+		if (loader.joinable())
+		{
+			loader.join();
+		}
+
+		delete loadingScene;
+
 		for (auto scene : scenes)
 		{
 			delete scene;
@@ -32,6 +46,11 @@ namespace sge
 		scenes.back()->draw();
 	}
 
+	bool SceneManager::snapshot(FrameSnapshot& snapshot)
+	{
+		return scenes.back()->snapshot(snapshot);
+	}
+
 	void SceneManager::push(Scene* scene)
 	{
 		newScene = scene;
@@ -49,15 +68,97 @@ namespace sge
 		sceneAction = CHANGE;
 	}
 
-	void SceneManager::handleScenes()
+	void SceneManager::changeAsync(Scene* scene)
+	{
+		startLoading(scene, CHANGE);
+	}
+
+	void SceneManager::pushAsync(Scene* scene)
+	{
+		startLoading(scene, PUSH);
+	}
+
+	void SceneManager::startLoading(Scene* scene, SceneAction action)
 	{
-		switch (sceneAction)
+		SGE_ASSERT(scene != nullptr);
+		SGE_ASSERT(loadingScene == nullptr);
+
+		loadingScene = scene;
+		loadingAction = action;
+		loaded = false;
+
+		loader = std::thread([this, scene]()
+		{
+			scene->load(pool);
+			loaded = true;
+		});
+	}
+
+	void SceneManager::loadNow(Scene* scene)
+	{
+		// A load still running on the loader thread shares the pool and the resources,
+		// let it complete before this one starts.
+		if (loader.joinable())
+		{
+			loader.join();
+		}
+
+		// load() only returns once every batch it dispatched is done, so the scene is
+		// fully loaded here. Each prepare() step then creates the next GPU resources.
+		scene->load(pool);
+
+		bool prepared = false;
+		while (!prepared)
+		{
+			prepared = scene->prepare();
+		}
+	}
+
+	bool SceneManager::handleScenes()
+	{
+		Scene* active = scenes.empty() ? nullptr : scenes.back();
+
+		if (newScene)
+		{
+			loadNow(newScene);
+		}
+
+		apply(sceneAction, newScene);
+
+		newScene = nullptr;
+		sceneAction = NONE;
+
+		// The switch waits until the loader is done and the scene has finished preparing,
+		// the current scene keeps running meanwhile.
+		if (loadingScene && loaded)
+		{
+			if (loader.joinable())
+			{
+				loader.join();
+			}
+
+			if (loadingScene->prepare())
+			{
+				Scene* scene = loadingScene;
+				loadingScene = nullptr;
+
+				apply(loadingAction, scene);
+				loadingAction = NONE;
+			}
+		}
+
+		return scenes.empty() ? active != nullptr : scenes.back() != active;
+	}
+
+	void SceneManager::apply(SceneAction action, Scene* scene)
+	{
+		switch (action)
 		{
 		case PUSH:
 		{
-			if (newScene)
+			if (scene)
 			{
-				scenes.push_back(newScene);
+				scenes.push_back(scene);
 			}
 			break;
 		}
@@ -72,7 +173,7 @@ namespace sge
 		}
 		case CHANGE:
 		{
-			if (newScene)
+			if (scene)
 			{
 				if (!scenes.empty())
 				{
@@ -80,7 +181,7 @@ namespace sge
 					scenes.pop_back();
 				}
 
-				scenes.push_back(newScene);
+				scenes.push_back(scene);
 			}
 			break;
 		}
@@ -90,8 +191,5 @@ namespace sge
 			break;
 		}
 		}
-
-		newScene = nullptr;
-		sceneAction = NONE;
 	}
 };
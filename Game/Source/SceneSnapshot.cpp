@@ -0,0 +1,413 @@
+#include "Game/SceneSnapshot.h"
+#include "Game/EntityManager.h"
+#include "Game/SystemManager.h"
+#include "Game/TransformComponent.h"
+#include "Core/MappedFile.h"
+
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+namespace sge
+{
+	namespace
+	{
+		const char MAGIC[4] = { 'S', 'G', 'E', 'S' };
+
+		void appendBytes(std::vector<char>& out, const void* data, size_t size)
+		{
+			const char* bytes = static_cast<const char*>(data);
+			out.insert(out.end(), bytes, bytes + size);
+		}
+
+		template <typename T>
+		void append(std::vector<char>& out, const T& value)
+		{
+			appendBytes(out, &value, sizeof(T));
+		}
+
+		// Bounds checked reads from the file. Values are copied out since the data isn't aligned.
+		class Reader
+		{
+		public:
+			Reader(const void* data, size_t size) : data(static_cast<const char*>(data)), size(size), offset(0)
+			{
+			}
+
+			template <typename T>
+			bool read(T& value)
+			{
+				const char* bytes = skip(sizeof(T));
+
+				if (bytes == nullptr)
+				{
+					return false;
+				}
+
+				std::memcpy(&value, bytes, sizeof(T));
+				return true;
+			}
+
+			/** Returns the next bytes and moves past them, or nullptr if the file is too short. */
+			const char* skip(size_t bytes)
+			{
+				if (bytes > size - offset)
+				{
+					return nullptr;
+				}
+
+				const char* result = data + offset;
+				offset += bytes;
+				return result;
+			}
+
+		private:
+			const char* data;
+			size_t size;
+			size_t offset;
+		};
+
+		struct FieldCopy
+		{
+			uint32 source;
+			uint32 destination;
+			uint32 size;
+		};
+	}
+
+	const SceneSnapshot::Binding* SceneSnapshot::findBinding(uint32 typeId) const
+	{
+		for (auto& binding : bindings)
+		{
+			if (binding.reflection->getTypeId() == typeId)
+			{
+				return &binding;
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool SceneSnapshot::save(const std::string& path, EntityManager& entityManager)
+	{
+		const std::vector<Entity*>& entities = entityManager.getEntities();
+
+		std::unordered_map<Entity*, uint32> indices;
+		indices.reserve(entities.size());
+
+		for (size_t i = 0; i < entities.size(); i++)
+		{
+			indices.emplace(entities[i], static_cast<uint32>(i));
+		}
+
+		std::vector<EntityRecord> records(entities.size());
+		std::vector<char> strings;
+		std::unordered_map<std::string, uint32> tagOffsets;
+
+		for (size_t i = 0; i < entities.size(); i++)
+		{
+			const std::string& tag = entities[i]->getTag();
+			auto tagOffset = tagOffsets.find(tag);
+
+			if (tagOffset == tagOffsets.end())
+			{
+				tagOffset = tagOffsets.emplace(tag, static_cast<uint32>(strings.size())).first;
+				appendBytes(strings, tag.c_str(), tag.size() + 1);
+			}
+
+			records[i].tag = tagOffset->second;
+			records[i].parent = NO_PARENT;
+
+			TransformComponent* transform = entities[i]->getComponent<TransformComponent>();
+
+			if (transform && transform->getParentTransform())
+			{
+				auto parent = indices.find(transform->getParentTransform()->getParent());
+
+				if (parent != indices.end())
+				{
+					records[i].parent = parent->second;
+				}
+			}
+		}
+
+		FileHeader header;
+		std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.version = VERSION;
+		header.entityCount = static_cast<uint32>(entities.size());
+		header.stringsSize = static_cast<uint32>(strings.size());
+		header.chunkCount = static_cast<uint32>(bindings.size());
+
+		std::vector<char> out;
+		append(out, header);
+		appendBytes(out, records.data(), records.size() * sizeof(EntityRecord));
+		appendBytes(out, strings.data(), strings.size());
+
+		std::vector<const void*> objects;
+		std::vector<Entity*> owners;
+
+		for (auto& binding : bindings)
+		{
+			const ComponentReflection& reflection = *binding.reflection;
+			binding.collect(binding.factory, objects, owners);
+
+			size_t headerOffset = out.size();
+			ChunkHeader chunk = { reflection.getTypeId(), static_cast<uint32>(reflection.getFields().size()), static_cast<uint32>(sizeof(uint32) + reflection.getDataSize()), 0 };
+			append(out, chunk);
+
+			for (auto& field : reflection.getFields())
+			{
+				FieldRecord record = { field.nameHash, field.size };
+				append(out, record);
+			}
+
+			out.reserve(out.size() + objects.size() * chunk.recordSize);
+
+			for (size_t i = 0; i < objects.size(); i++)
+			{
+				auto owner = indices.find(owners[i]);
+
+				// Components of entities the manager doesn't own can't be restored.
+				if (owner == indices.end())
+				{
+					continue;
+				}
+
+				append(out, owner->second);
+
+				for (auto& field : reflection.getFields())
+				{
+					appendBytes(out, static_cast<const char*>(objects[i]) + field.offset, field.size);
+				}
+
+				chunk.count++;
+			}
+
+			std::memcpy(&out[headerOffset], &chunk, sizeof(chunk));
+		}
+
+		FILE* file = std::fopen(path.c_str(), "wb");
+
+		if (file == nullptr)
+		{
+			return false;
+		}
+
+		bool written = std::fwrite(out.data(), 1, out.size(), file) == out.size();
+		return std::fclose(file) == 0 && written;
+	}
+
+	bool SceneSnapshot::load(const std::string& path, EntityManager& entityManager, SystemManager* systemManager)
+	{
+		loaded.clear();
+
+		MappedFile file;
+
+		if (!file.open(path))
+		{
+			return false;
+		}
+
+		Reader reader(file.getData(), file.getSize());
+		FileHeader header;
+
+		if (!reader.read(header) || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version == 0 || header.version > VERSION)
+		{
+			return false;
+		}
+
+		const char* records = reader.skip(static_cast<size_t>(header.entityCount) * sizeof(EntityRecord));
+		const char* strings = reader.skip(header.stringsSize);
+
+		if (records == nullptr || strings == nullptr || (header.stringsSize > 0 && strings[header.stringsSize - 1] != '\0'))
+		{
+			return false;
+		}
+
+		// Check the hierarchy and the chunks before creating anything so a broken file leaves the scene untouched.
+		std::vector<uint32> parents(header.entityCount);
+
+		for (uint32 i = 0; i < header.entityCount; i++)
+		{
+			EntityRecord record;
+			std::memcpy(&record, records + i * sizeof(EntityRecord), sizeof(record));
+
+			if (record.parent != NO_PARENT && (record.parent >= header.entityCount || record.parent == i))
+			{
+				return false;
+			}
+
+			parents[i] = record.parent;
+		}
+
+		// Walks up from each entity, reaching an entity of the current walk again means a cycle.
+		enum : uint8 { UNVISITED, VISITING, VISITED };
+		std::vector<uint8> states(header.entityCount, UNVISITED);
+		std::vector<uint32> walk;
+
+		for (uint32 i = 0; i < header.entityCount; i++)
+		{
+			walk.clear();
+			uint32 current = i;
+
+			while (current != NO_PARENT && states[current] == UNVISITED)
+			{
+				states[current] = VISITING;
+				walk.push_back(current);
+				current = parents[current];
+			}
+
+			if (current != NO_PARENT && states[current] == VISITING)
+			{
+				return false;
+			}
+
+			for (auto entity : walk)
+			{
+				states[entity] = VISITED;
+			}
+		}
+
+		Reader chunkReader = reader;
+
+		for (uint32 i = 0; i < header.chunkCount; i++)
+		{
+			ChunkHeader chunk;
+
+			if (!chunkReader.read(chunk))
+			{
+				return false;
+			}
+
+			// Summed in 64 bits so huge sizes can't wrap around to the record size. Every field
+			// ends inside the record, which keeps the copy offsets of the second pass in range.
+			uint64 recordEnd = sizeof(uint32);
+
+			for (uint32 j = 0; j < chunk.fieldCount; j++)
+			{
+				FieldRecord field;
+
+				if (!chunkReader.read(field))
+				{
+					return false;
+				}
+
+				recordEnd += field.size;
+
+				if (recordEnd > chunk.recordSize)
+				{
+					return false;
+				}
+			}
+
+			if (recordEnd != chunk.recordSize ||
+				chunkReader.skip(static_cast<size_t>(chunk.count) * chunk.recordSize) == nullptr)
+			{
+				return false;
+			}
+		}
+
+		loaded.reserve(header.entityCount);
+
+		for (uint32 i = 0; i < header.entityCount; i++)
+		{
+			EntityRecord record;
+			std::memcpy(&record, records + i * sizeof(EntityRecord), sizeof(record));
+
+			Entity* entity = entityManager.createEntity();
+
+			if (record.tag < header.stringsSize)
+			{
+				entity->setTag(strings + record.tag);
+			}
+
+			loaded.push_back(entity);
+		}
+
+		std::vector<FieldCopy> copies;
+
+		for (uint32 i = 0; i < header.chunkCount; i++)
+		{
+			ChunkHeader chunk;
+			reader.read(chunk);
+
+			const Binding* binding = findBinding(chunk.typeId);
+
+			// Match the saved members to the current ones, members that were removed or resized are skipped.
+			copies.clear();
+			uint32 source = sizeof(uint32);
+
+			for (uint32 j = 0; j < chunk.fieldCount; j++)
+			{
+				FieldRecord field;
+				reader.read(field);
+
+				if (binding)
+				{
+					for (auto& reflected : binding->reflection->getFields())
+					{
+						if (reflected.nameHash == field.nameHash && reflected.size == field.size)
+						{
+							FieldCopy copy = { source, reflected.offset, field.size };
+							copies.push_back(copy);
+							break;
+						}
+					}
+				}
+
+				source += field.size;
+			}
+
+			const char* data = reader.skip(static_cast<size_t>(chunk.count) * chunk.recordSize);
+
+			if (binding == nullptr)
+			{
+				continue;
+			}
+
+			for (uint32 j = 0; j < chunk.count; j++)
+			{
+				const char* record = data + static_cast<size_t>(j) * chunk.recordSize;
+
+				uint32 owner;
+				std::memcpy(&owner, record, sizeof(owner));
+
+				if (owner >= header.entityCount)
+				{
+					continue;
+				}
+
+				Component* component = nullptr;
+				char* object = static_cast<char*>(binding->create(binding->factory, loaded[owner], &component));
+
+				for (auto& copy : copies)
+				{
+					std::memcpy(object + copy.destination, record + copy.source, copy.size);
+				}
+
+				if (systemManager)
+				{
+					systemManager->addComponent(component);
+				}
+			}
+		}
+
+		for (uint32 i = 0; i < header.entityCount; i++)
+		{
+			if (parents[i] == NO_PARENT)
+			{
+				continue;
+			}
+
+			TransformComponent* transform = loaded[i]->getComponent<TransformComponent>();
+			TransformComponent* parent = loaded[parents[i]]->getComponent<TransformComponent>();
+
+			if (transform && parent)
+			{
+				transform->setParentTransform(parent);
+			}
+		}
+
+		return true;
+	}
+}
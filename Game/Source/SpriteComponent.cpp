@@ -13,7 +13,6 @@ namespace sge
         pipeline(nullptr)
 	{
 		transform = getParent()->getComponent<TransformComponent>();
-        key.fields.translucent = (color.a < 1.0f) ? 1 : 0;
 
 		SGE_ASSERT(transform);
 	}
@@ -25,7 +24,6 @@ namespace sge
         pipeline(nullptr)
 	{
 		transform = getParent()->getComponent<TransformComponent>();
-        key.fields.translucent = (color.a < 1.0f) ? 1 : 0;
 
 		SGE_ASSERT(transform);
 	}
@@ -34,13 +32,6 @@ namespace sge
 	{
 	}
 
-	void SpriteComponent::render(GraphicsDevice* device)
-	{
-        SGE_ASSERT(renderer);
-
-        renderer->renderSprite(this);
-	}
-
 	void SpriteComponent::update()
 	{
 	}
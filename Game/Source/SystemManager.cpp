@@ -7,10 +7,48 @@
 #include "Game/TransformComponent.h"
 #include "Game/SpriteComponent.h"
 
+#include <algorithm>
 #include <typeinfo>
 
 namespace sge
 {
+	namespace
+	{
+		bool overlaps(const std::vector<size_t>& lhs, const std::vector<size_t>& rhs)
+		{
+			for (auto type : lhs)
+			{
+				if (std::find(rhs.begin(), rhs.end(), type) != rhs.end())
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		// Two systems conflict when one of them writes something the other one touches.
+		// Systems without declarations are assumed to touch everything.
+		bool conflicts(const System* lhs, const System* rhs)
+		{
+			if (!lhs->declaresAccess() || !rhs->declaresAccess())
+			{
+				return true;
+			}
+
+			return overlaps(lhs->getWriteTypes(), rhs->getWriteTypes()) ||
+				overlaps(lhs->getWriteTypes(), rhs->getReadTypes()) ||
+				overlaps(lhs->getReadTypes(), rhs->getWriteTypes());
+		}
+	}
+
+	SystemManager::SystemManager(size_t workerCount) :
+		entityManager(nullptr),
+		pool(workerCount),
+		serial(false),
+		dirty(false)
+	{
+	}
 
 	void SystemManager::addComponent(Component* component)
 	{
@@ -23,17 +61,154 @@ namespace sge
 		}
 	}
 
+	void SystemManager::removeComponent(Component* component)
+	{
+		for (auto& system : systems)
+		{
+			if (typeid(*component).hash_code() == system.first)
+			{
+				system.second->removeComponent(component);
+			}
+		}
+	}
+
 	void SystemManager::addSystem(System* system, size_t type)
 	{
 		systems.emplace(type, system);
+
+		if (std::find(ordered.begin(), ordered.end(), system) == ordered.end())
+		{
+			ordered.push_back(system);
+			system->setThreadPool(serial ? nullptr : &pool);
+			system->setEventBus(&events);
+			dirty = true;
+		}
 	}
 
 	void SystemManager::updateSystems()
 	{
-		for (auto& system : systems)
+		if (dirty)
+		{
+			buildStages();
+		}
+
+		events.dispatch();
+
+		size_t stageIndex = 0;
+
+		for (auto phaseEnd : phaseEnds)
 		{
-			system.second->update();
+			unsigned int phase = stages[stageIndex].front()->getPhase();
+
+			for (; stageIndex < phaseEnd; stageIndex++)
+			{
+				Stage& stage = stages[stageIndex];
+
+				for (auto system : stage)
+				{
+					system->beginUpdate();
+				}
+
+				if (serial || stage.size() == 1)
+				{
+					for (auto system : stage)
+					{
+						system->update();
+					}
+					continue;
+				}
+
+				pool.dispatch(stage.size(), [&stage](size_t i)
+				{
+					stage[i]->update();
+				});
+			}
+
+			// Single sync point for the structural changes recorded during the phase.
+			playbackCommands(phase);
 		}
 	}
 
-}
\ No newline at end of file
+	void SystemManager::playbackCommands(unsigned int phase)
+	{
+		if (entityManager == nullptr)
+		{
+			return;
+		}
+
+		for (auto system : ordered)
+		{
+			if (system->getPhase() == phase && !system->getCommands().isEmpty())
+			{
+				system->getCommands().playback(*entityManager, this);
+			}
+		}
+	}
+
+	void SystemManager::setSerial(bool serial)
+	{
+		this->serial = serial;
+
+		for (auto system : ordered)
+		{
+			system->setThreadPool(serial ? nullptr : &pool);
+		}
+	}
+
+	void SystemManager::buildStages()
+	{
+		std::vector<System*> sorted(ordered);
+
+		std::stable_sort(sorted.begin(), sorted.end(), [](const System* lhs, const System* rhs)
+		{
+			return lhs->getPhase() < rhs->getPhase();
+		});
+
+		// A system's level is one past the highest level of any earlier conflicting system in
+		// the same phase. Systems sharing a level don't conflict and can run side by side,
+		// while conflicting pairs still run in the order they were added.
+		std::vector<size_t> levels(sorted.size(), 0);
+		size_t phaseBegin = 0;
+		size_t stageBase = 0;
+		size_t phaseStages = 0;
+
+		stages.clear();
+		phaseEnds.clear();
+
+		for (size_t i = 0; i < sorted.size(); i++)
+		{
+			if (sorted[i]->getPhase() != sorted[phaseBegin]->getPhase())
+			{
+				phaseBegin = i;
+				stageBase += phaseStages;
+				phaseStages = 0;
+				phaseEnds.push_back(stageBase);
+			}
+
+			for (size_t j = phaseBegin; j < i; j++)
+			{
+				if (levels[j] >= levels[i] && conflicts(sorted[j], sorted[i]))
+				{
+					levels[i] = levels[j] + 1;
+				}
+			}
+
+			phaseStages = std::max(phaseStages, levels[i] + 1);
+
+			if (stages.size() < stageBase + phaseStages)
+			{
+				stages.resize(stageBase + phaseStages);
+			}
+
+			stages[stageBase + levels[i]].push_back(sorted[i]);
+		}
+
+		if (!stages.empty())
+		{
+			phaseEnds.push_back(stages.size());
+		}
+
+		dirty = false;
+	}
+
+}
@@ -1,4 +1,5 @@
 #include "Game/TestSystem.h"
+#include <algorithm>
 #include <typeinfo>
 
 namespace sge
@@ -39,4 +40,10 @@ namespace sge
 		}
 	}
 
-}
+	void TestSystem::removeComponent(Component* comp)
+	{
+		comps1.erase(std::remove(comps1.begin(), comps1.end(), comp), comps1.end());
+		comps2.erase(std::remove(comps2.begin(), comps2.end(), comp), comps2.end());
+	}
+
+}
\ No newline at end of file
@@ -32,11 +32,6 @@ namespace sge
 	{
 	}
 
-	void TextComponent::render(GraphicsDevice* device)
-	{
-        renderer->renderText(this);
-	}
-
 	void TextComponent::update()
 	{
 	}
@@ -1,8 +1,12 @@
 #include "Game/TransformComponent.h"
+#include "Core/Assert.h"
+#include <algorithm>
 #include <iostream>
 namespace sge
 {
-	TransformComponent::TransformComponent(Entity* ent) : 
+	unsigned int TransformComponent::hierarchyVersion = 0;
+
+	TransformComponent::TransformComponent(Entity* ent) :
         Component(ent),
         position(0.0f),
         scale(1.0f),
@@ -10,7 +14,111 @@ namespace sge
         front(0.0f, 0.0f, 1.0f),
         up(0.0f, 1.0f, 0.0f),
         left(1.0f, 0.0f, 0.0f),
-        angle(0.0f)
+        angle(0.0f),
+        localMatrix(1.0f),
+        worldMatrix(1.0f),
+        dirty(true),
+        worldDirty(true),
+        parentTransform(nullptr)
 	{
 	}
-}
\ No newline at end of file
+
+	TransformComponent::~TransformComponent()
+	{
+		// Children are left in place as roots.
+		while (!childTransforms.empty())
+		{
+			childTransforms.back()->setParentTransform(nullptr);
+		}
+
+		setParentTransform(nullptr);
+	}
+
+	void TransformComponent::setParentTransform(TransformComponent* parent)
+	{
+		if (parent == parentTransform)
+		{
+			return;
+		}
+
+		// Parenting to our own descendant would make a cycle.
+		for (TransformComponent* ancestor = parent; ancestor; ancestor = ancestor->parentTransform)
+		{
+			SGE_ASSERT(ancestor != this);
+		}
+
+		if (parentTransform)
+		{
+			std::vector<TransformComponent*>& siblings = parentTransform->childTransforms;
+			siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
+		}
+
+		parentTransform = parent;
+
+		if (parentTransform)
+		{
+			parentTransform->childTransforms.push_back(this);
+		}
+
+		// Force the subtree to pick up the new parent matrix.
+		worldDirty = false;
+		markWorldDirty();
+
+		hierarchyVersion++;
+	}
+
+	const ComponentReflection& TransformComponent::getReflection()
+	{
+		static const ComponentReflection reflection = ComponentReflection("TransformComponent")
+			.field("position", &TransformComponent::position)
+			.field("scale", &TransformComponent::scale)
+			.field("rotationVector", &TransformComponent::rotationVector)
+			.field("front", &TransformComponent::front)
+			.field("up", &TransformComponent::up)
+			.field("left", &TransformComponent::left)
+			.field("angle", &TransformComponent::angle);
+
+		return reflection;
+	}
+
+	void TransformComponent::markWorldDirty()
+	{
+		// A dirty world matrix means the subtree below is dirty too, so stop there.
+		if (worldDirty)
+		{
+			return;
+		}
+
+		worldDirty = true;
+
+		for (auto child : childTransforms)
+		{
+			child->markWorldDirty();
+		}
+	}
+
+	void TransformComponent::updateMatrix()
+	{
+		if (dirty)
+		{
+			localMatrix =
+				math::translate(math::mat4(1.0f), position) *
+				math::rotate(math::mat4(1.0f), angle, rotationVector) *
+				math::scale(math::mat4(1.0f), scale);
+
+			dirty = false;
+		}
+
+		if (parentTransform)
+		{
+			worldMatrix = parentTransform->getMatrix() * localMatrix;
+		}
+		else
+		{
+			worldMatrix = localMatrix;
+		}
+
+		worldDirty = false;
+		markChanged();
+	}
+}
@@ -1,9 +1,23 @@
 #include "Game/TransformSystem.h"
 
+#include <algorithm>
+#include <iterator>
+#include <unordered_set>
+
 namespace sge
 {
-	TransformSystem::TransformSystem() : System()
+	namespace
 	{
+		const size_t CHUNK_SIZE = 512; // Transforms handed to a worker at a time.
+		const size_t SUBTREE_CHUNK_SIZE = 16; // Root subtrees handed to a worker at a time.
+	}
+
+	TransformSystem::TransformSystem() : System(),
+		hierarchyVersion(0),
+		sorted(false),
+		parallelSubtrees(false)
+	{
+		writesComponent<TransformComponent>();
 	}
 
 
@@ -13,16 +27,100 @@ namespace sge
 
 	void TransformSystem::update()
 	{
-		for (size_t i = 0; i < comps.size(); i++)
+		if (!sorted || hierarchyVersion != TransformComponent::getHierarchyVersion())
+		{
+			sortHierarchy();
+		}
+
+		if (parallelSubtrees)
+		{
+			parallelFor(rootBegins.size() - 1, SUBTREE_CHUNK_SIZE, [this](size_t begin, size_t end)
+			{
+				updateRange(rootBegins[begin], rootBegins[end]);
+			});
+		}
+		else if (rootBegins.size() - 1 == ordered.size())
+		{
+			// Flat scene, every transform is independent.
+			parallelFor(ordered.size(), CHUNK_SIZE, [this](size_t begin, size_t end)
+			{
+				updateRange(begin, end);
+			});
+		}
+		else
+		{
+			updateRange(0, ordered.size());
+		}
+	}
+
+	void TransformSystem::updateRange(size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
 		{
-			comps[i]->update();
+			ordered[i]->update();
 		}
 	}
 
+	void TransformSystem::sortHierarchy()
+	{
+		std::unordered_set<TransformComponent*> members(comps.begin(), comps.end());
+
+		ordered.clear();
+		rootBegins.clear();
+
+		std::vector<TransformComponent*> stack;
+
+		for (auto comp : comps)
+		{
+			// Transforms whose parent isn't in this system are treated as roots.
+			if (comp->getParentTransform() && members.count(comp->getParentTransform()))
+			{
+				continue;
+			}
+
+			rootBegins.push_back(ordered.size());
+			stack.push_back(comp);
+
+			while (!stack.empty())
+			{
+				TransformComponent* current = stack.back();
+				stack.pop_back();
+
+				ordered.push_back(current);
+
+				const std::vector<TransformComponent*>& children = current->getChildTransforms();
+
+				for (auto it = children.rbegin(); it != children.rend(); ++it)
+				{
+					if (members.count(*it))
+					{
+						stack.push_back(*it);
+					}
+				}
+			}
+		}
+
+		rootBegins.push_back(ordered.size());
+
+		hierarchyVersion = TransformComponent::getHierarchyVersion();
+		sorted = true;
+	}
 
 	void TransformSystem::addComponent(Component* comp)
 	{
 		comps.push_back(dynamic_cast<TransformComponent*>(comp));
+		sorted = false;
+	}
+
+	void TransformSystem::removeComponent(Component* comp)
+	{
+		auto it = std::find(comps.rbegin(), comps.rend(), comp);
+
+		if (it != comps.rend())
+		{
+			comps.erase(std::next(it).base());
+			sorted = false;
+		}
 	}
 
 }
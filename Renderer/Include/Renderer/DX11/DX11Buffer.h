@@ -13,6 +13,11 @@ namespace sge
 		Buffer header;
 
 		ID3D11Buffer* buffer;
+
+		// Stream buffers only. Dynamic constant buffers can't stay mapped, so the ranges are
+		// written to a copy in memory and uploaded when they are bound.
+		char* streamData;
+		size_t streamHead;
 	};
 }
 
@@ -31,6 +31,12 @@ namespace sge
 		DYNAMIC
 	};
 
+	enum class IndexFormat
+	{
+		UINT16,
+		UINT32
+	};
+
 	enum class PrimitiveTopology
 	{
 		TRIANGLE
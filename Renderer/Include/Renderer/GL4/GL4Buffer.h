@@ -8,6 +8,10 @@
 
 namespace sge
 {
+	// Parts of a stream buffer, one per frame in flight. A part is fenced at the end of the frame that
+	// wrote it and written again once the GPU has passed that fence.
+	const size_t STREAM_REGIONS = 3;
+
 	struct GL4Buffer 
 	{
 		Buffer header;
@@ -15,6 +19,12 @@ namespace sge
 		GLuint id;
 		GLenum target;
 		GLenum usage;
+
+		// Stream buffers only.
+		char* mapped;
+		size_t streamHead;
+		size_t streamRegion;
+		GLsync fences[STREAM_REGIONS];
 	};
 }
 
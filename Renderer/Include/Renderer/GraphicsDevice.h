@@ -18,69 +18,133 @@ namespace sge
 	struct VertexLayoutDescription;
 	struct Viewport;
 
+	/** \brief Device of the graphics API the engine was built for.
+	*
+	* The functions are virtual so a NullGraphicsDevice can stand in for it where there is no display.
+	*/
 	class GraphicsDevice
 	{
 	public:
-		GraphicsDevice(Window& window);
-		~GraphicsDevice();
-
-		void init();
-		void deinit();
-
-		void clear(float r, float g, float b, float a);
-
-		void swap();
-
-		Buffer* createBuffer(BufferType type, BufferUsage usage, size_t size);
-		void deleteBuffer(Buffer* buffer);
-
-		Pipeline* createPipeline(VertexLayoutDescription* vertexLayoutDescription, Shader* vertexShader, Shader* pixelShader);
-		void deletePipeline(Pipeline* pipeline);
-
-        RenderTarget* createRenderTarget(size_t count, size_t width, size_t height, bool depth = false, bool stencil = false);
-        void deleteRenderTarget(RenderTarget* renderTarget);
-
-		Shader* createShader(ShaderType type, const char* source, size_t size);
-		void deleteShader(Shader* shader);
-
-        Texture* createTexture(TextureResource* source);
-        Texture* createTextTexture(TextureResource* source);
-
-        Texture* createTexture(size_t width, size_t height, unsigned char* source = 0, Format format = Format::RGBA);
-        Texture* createTextTexture(size_t width, size_t height, unsigned char* source);
+		/** \brief State changes sent to the graphics API and ones skipped because the state was already set. */
+		struct StateCounters
+		{
+			size_t issued;
+			size_t skipped;
+		};
 
-		void deleteTexture(Texture* texture);
-
-        CubeMap* createCubeMap(TextureResource* source[]);
-		void deleteCubeMap(CubeMap* cubeMap);
-
-		void bindPipeline(Pipeline* pipeline);
-		void debindPipeline(Pipeline* pipeline);
-
-        void bindRenderTarget(RenderTarget* renderTarget);
-        void debindRenderTarget();
-
-		void bindVertexBuffer(Buffer* buffer);
-		void bindIndexBuffer(Buffer* buffer);
-		void bindVertexUniformBuffer(Buffer* buffer, size_t slot);
-		void bindPixelUniformBuffer(Buffer* buffer, size_t slot);
-
-		void bindViewport(Viewport* viewport);
-
-		void bindTexture(Texture* texture, size_t slot);
-		void debindTexture(Texture* texture, size_t slot);
-
-		void bindCubeMap(CubeMap* cubeMap, size_t slot);
-		void debindCubeMap(CubeMap* cubeMap, size_t slot);
-
-		void copyData(Buffer* buffer, size_t size, const void* data);
-		void copySubData(Buffer* buffer, size_t offset, size_t size, const void* data);
+		GraphicsDevice(Window& window);
+		virtual ~GraphicsDevice();
 
-		void draw(size_t count);
-		void drawIndexed(size_t count);
-		void drawInstanced(size_t count, size_t instanceCount);
-		void drawInstancedIndexed(size_t count, size_t instanceCount);
+		virtual void init();
+		virtual void deinit();
+
+		/** \brief True for a NullGraphicsDevice, which has no context. */
+		virtual bool isHeadless() const
+		{
+			return false;
+		}
+
+		/** \brief Counts of the state changes since the last reset.
+		*
+		* Binds of a pipeline, buffer, texture or viewport that is already bound are skipped. Pipelines and
+		* textures are applied right before the next draw, so a debind followed by the same bind costs nothing.
+		*/
+		virtual const StateCounters& getStateCounters() const;
+		virtual void resetStateCounters();
+
+		virtual void clear(float r, float g, float b, float a);
+
+		virtual void swap();
+
+		virtual Buffer* createBuffer(BufferType type, BufferUsage usage, size_t size);
+		virtual void deleteBuffer(Buffer* buffer);
+
+		/** \brief Creates a uniform buffer for data that is written for every draw.
+		*
+		* The buffer stays mapped and is used as a ring, allocateStreamData hands out the next free range.
+		* Ranges are bound with the offset versions of bindVertexUniformBuffer and bindPixelUniformBuffer.
+		*
+		* \param size_t size : Bytes one frame writes, the buffer holds this for every frame in flight.
+		*/
+		virtual Buffer* createStreamBuffer(size_t size);
+
+		/** \brief Reserves a range of a stream buffer for the CPU to write.
+		*
+		* A frame writes its own part of the buffer, swap() ends the frame. The first write of a frame waits
+		* for the GPU if it still reads that part from an earlier frame. A frame that writes more than the
+		* size the buffer was created with grows the buffer instead of overwriting its own ranges.
+		*
+		* \param size_t& offset : Set to the offset of the range, bind the range with it.
+		* \return Pointer the data is written to, valid until the range is bound. Nullptr on a NullGraphicsDevice.
+		*/
+		virtual void* allocateStreamData(Buffer* buffer, size_t size, size_t& offset);
+
+		virtual Pipeline* createPipeline(VertexLayoutDescription* vertexLayoutDescription, Shader* vertexShader, Shader* pixelShader);
+		virtual void deletePipeline(Pipeline* pipeline);
+
+        virtual RenderTarget* createRenderTarget(size_t count, size_t width, size_t height, bool depth = false, bool stencil = false);
+        virtual void deleteRenderTarget(RenderTarget* renderTarget);
+
+		virtual Shader* createShader(ShaderType type, const char* source, size_t size);
+		virtual void deleteShader(Shader* shader);
+
+        virtual Texture* createTexture(TextureResource* source);
+        virtual Texture* createTextTexture(TextureResource* source);
+
+        virtual Texture* createTexture(size_t width, size_t height, unsigned char* source = 0, Format format = Format::RGBA);
+        virtual Texture* createTextTexture(size_t width, size_t height, unsigned char* source);
+
+		/** \brief Overwrites a region of a texture made with createTextTexture.
+		*
+		* The mipmaps aren't updated, call generateMipmaps once the copies are done.
+		* \param const unsigned char* source : Tightly packed rows of one byte per pixel.
+		*/
+		virtual void copyTextTextureData(Texture* texture, size_t x, size_t y, size_t width, size_t height, const unsigned char* source);
+
+		/** \brief Recomputes the mipmaps of a texture from its full size level. */
+		virtual void generateMipmaps(Texture* texture);
+
+		virtual void deleteTexture(Texture* texture);
+
+        virtual CubeMap* createCubeMap(TextureResource* source[]);
+		virtual void deleteCubeMap(CubeMap* cubeMap);
+
+		virtual void bindPipeline(Pipeline* pipeline);
+		virtual void debindPipeline(Pipeline* pipeline);
+
+        virtual void bindRenderTarget(RenderTarget* renderTarget);
+        virtual void debindRenderTarget();
+
+		virtual void bindVertexBuffer(Buffer* buffer);
+		virtual void bindIndexBuffer(Buffer* buffer, IndexFormat format = IndexFormat::UINT32);
+		virtual void bindVertexUniformBuffer(Buffer* buffer, size_t slot);
+		virtual void bindPixelUniformBuffer(Buffer* buffer, size_t slot);
+		virtual void bindVertexUniformBuffer(Buffer* buffer, size_t slot, size_t offset, size_t size);
+		virtual void bindPixelUniformBuffer(Buffer* buffer, size_t slot, size_t offset, size_t size);
+
+		virtual void bindViewport(const Viewport* viewport);
+
+		virtual void bindTexture(Texture* texture, size_t slot);
+		virtual void debindTexture(Texture* texture, size_t slot);
+
+		virtual void bindCubeMap(CubeMap* cubeMap, size_t slot);
+		virtual void debindCubeMap(CubeMap* cubeMap, size_t slot);
+
+		virtual void copyData(Buffer* buffer, size_t size, const void* data);
+		virtual void copySubData(Buffer* buffer, size_t offset, size_t size, const void* data);
+
+		virtual void draw(size_t count);
+		virtual void drawIndexed(size_t count);
+		virtual void drawInstanced(size_t count, size_t instanceCount);
+		virtual void drawInstancedIndexed(size_t count, size_t instanceCount);
 		
+	protected:
+		/** \brief For devices that have no backend, see NullGraphicsDevice. */
+		GraphicsDevice() :
+			impl(nullptr)
+		{
+		}
+
 	private:
 		struct Impl;
 		Impl* impl;
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Renderer/GraphicsDevice.h"
+
+namespace sge
+{
+	/** \brief GraphicsDevice for a headless Window.
+	*
+	* Has no context. Every call returns right away and the create functions return nullptr,
+	* so the CPU side of rendering still runs on machines without a display or GPU.
+	*/
+	class NullGraphicsDevice : public GraphicsDevice
+	{
+	public:
+		NullGraphicsDevice();
+		~NullGraphicsDevice();
+
+		void init() override {}
+		void deinit() override {}
+
+		bool isHeadless() const override
+		{
+			return true;
+		}
+
+		const StateCounters& getStateCounters() const override
+		{
+			return counters;
+		}
+
+		void resetStateCounters() override {}
+
+		void clear(float, float, float, float) override {}
+		void swap() override {}
+
+		Buffer* createBuffer(BufferType, BufferUsage, size_t) override { return nullptr; }
+		void deleteBuffer(Buffer*) override {}
+
+		Buffer* createStreamBuffer(size_t) override { return nullptr; }
+		void* allocateStreamData(Buffer* buffer, size_t size, size_t& offset) override;
+
+		Pipeline* createPipeline(VertexLayoutDescription*, Shader*, Shader*) override { return nullptr; }
+		void deletePipeline(Pipeline*) override {}
+
+		RenderTarget* createRenderTarget(size_t, size_t, size_t, bool, bool) override { return nullptr; }
+		void deleteRenderTarget(RenderTarget*) override {}
+
+		Shader* createShader(ShaderType, const char*, size_t) override { return nullptr; }
+		void deleteShader(Shader*) override {}
+
+		Texture* createTexture(TextureResource*) override { return nullptr; }
+		Texture* createTextTexture(TextureResource*) override { return nullptr; }
+
+		Texture* createTexture(size_t, size_t, unsigned char*, Format) override { return nullptr; }
+		Texture* createTextTexture(size_t, size_t, unsigned char*) override { return nullptr; }
+
+		void copyTextTextureData(Texture*, size_t, size_t, size_t, size_t, const unsigned char*) override {}
+		void generateMipmaps(Texture*) override {}
+
+		void deleteTexture(Texture*) override {}
+
+		CubeMap* createCubeMap(TextureResource*[]) override { return nullptr; }
+		void deleteCubeMap(CubeMap*) override {}
+
+		void bindPipeline(Pipeline*) override {}
+		void debindPipeline(Pipeline*) override {}
+
+		void bindRenderTarget(RenderTarget*) override {}
+		void debindRenderTarget() override {}
+
+		void bindVertexBuffer(Buffer*) override {}
+		void bindIndexBuffer(Buffer*, IndexFormat) override {}
+		void bindVertexUniformBuffer(Buffer*, size_t) override {}
+		void bindPixelUniformBuffer(Buffer*, size_t) override {}
+		void bindVertexUniformBuffer(Buffer*, size_t, size_t, size_t) override {}
+		void bindPixelUniformBuffer(Buffer*, size_t, size_t, size_t) override {}
+
+		void bindViewport(const Viewport*) override {}
+
+		void bindTexture(Texture*, size_t) override {}
+		void debindTexture(Texture*, size_t) override {}
+
+		void bindCubeMap(CubeMap*, size_t) override {}
+		void debindCubeMap(CubeMap*, size_t) override {}
+
+		void copyData(Buffer*, size_t, const void*) override {}
+		void copySubData(Buffer*, size_t, size_t, const void*) override {}
+
+		void draw(size_t) override {}
+		void drawIndexed(size_t) override {}
+		void drawInstanced(size_t, size_t) override {}
+		void drawInstancedIndexed(size_t, size_t) override {}
+
+	private:
+		StateCounters counters;
+	};
+}
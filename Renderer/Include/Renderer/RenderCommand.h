@@ -4,19 +4,98 @@
 
 namespace sge
 {
+	/** \brief Number of draw layers, a camera's layer mask has a bit for each. The layer field of a key holds all of them. */
+	const uint32 MAX_RENDER_LAYERS = 32;
+
+	/** \brief 64-bit sort key of a queued draw. The queue is drawn in ascending key order. */
 	union RenderCommand
 	{
-		struct Fields
+		uint64 bits;
+	};
+
+	/** \brief Values a sort key is built from. */
+	struct SortKeyFields
+	{
+		uint32 view;		/**< Camera or render pass. Views are drawn one after another. */
+		uint32 layer;		/**< Drawn in ascending order within a view, e.g. world before UI. */
+		bool translucent;	/**< Translucent draws come after the opaque ones of the same layer. */
+		uint32 pipeline;
+		uint32 material;
+		uint32 texture;
+		float depth;		/**< Distance from the camera along its front vector. */
+	};
+
+	/** \brief Number of bits each field gets in the key, the widths must add up to 64.
+	*
+	* Values wider than their field are truncated, so IDs from SortKeyEncoder::getId only
+	* group draws and don't need to be unique.
+	*/
+	struct SortKeyLayout
+	{
+		SortKeyLayout() :
+			viewBits(4),
+			layerBits(5),
+			pipelineBits(8),
+			materialBits(10),
+			textureBits(12),
+			depthBits(24)
 		{
-            uint64 data : 31;
-            uint64 depth : 32;
-            uint64 translucent : 1;
-        } fields;
+		}
 
-		uint64 bits;
+		uint8 viewBits;
+		uint8 layerBits;	/**< At least 5, for MAX_RENDER_LAYERS. */
+		uint8 pipelineBits;
+		uint8 materialBits;
+		uint8 textureBits;
+		uint8 depthBits;	/**< At most 32. */
 	};
 
-    // TODO translucent draws should be sorted by depth and from back to front
-    // while opaque draws should be sorted by used shaders, textures etc. and 
-    // from front to back. 
-}
\ No newline at end of file
+	/** \brief Builds RenderCommand keys that order the queue for few state changes and little overdraw.
+	*
+	* From the highest bits down a key holds the view, the layer and the translucency bit.
+	* Opaque draws continue with the pipeline, material and texture, and the depth last, so
+	* draws sharing state are adjacent and each group is drawn front to back. Translucent
+	* draws have to blend back to front, so their inverted depth comes right after the
+	* translucency bit and the state IDs only break ties.
+	*/
+	class SortKeyEncoder
+	{
+	public:
+		/** \brief The constructor.
+		*
+		* \param const SortKeyLayout& layout : Bit widths of the fields.
+		* \param float maxDepth : Depth that maps to the largest depth value, farther draws are clamped to it.
+		*/
+		explicit SortKeyEncoder(const SortKeyLayout& layout = SortKeyLayout(), float maxDepth = 1000.0f);
+
+		void setLayout(const SortKeyLayout& layout);
+		const SortKeyLayout& getLayout() const
+		{
+			return layout;
+		}
+
+		void setMaxDepth(float maxDepth);
+		float getMaxDepth() const
+		{
+			return maxDepth;
+		}
+
+		RenderCommand encode(const SortKeyFields& fields) const;
+
+		uint32 decodeView(const RenderCommand command) const;
+		uint32 decodeLayer(const RenderCommand command) const;
+		bool decodeTranslucent(const RenderCommand command) const;
+
+		/** \brief Folds the address of a GPU object or resource into an ID for the key. */
+		static uint32 getId(const void* object)
+		{
+			uint64 address = static_cast<uint64>(reinterpret_cast<uptr>(object)) >> 4;
+
+			return static_cast<uint32>(address ^ (address >> 32));
+		}
+
+	private:
+		SortKeyLayout layout;
+		float maxDepth;
+	};
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Core/Math.h"
+#include "Core/Types.h"
+#include "Renderer/Enumerations.h"
+
+namespace sge
+{
+	struct Buffer;
+	struct CubeMap;
+	struct Font;
+	struct Pipeline;
+	struct Texture;
+
+	// RENDER PACKETS
+	//
+	// Plain data describing a single draw. Packets are copied into the RenderQueue's
+	// arena when they are pushed, so they hold everything the draw needs by value and
+	// the scene can change freely before the queue is rendered. Only GPU objects are
+	// referenced by pointer. The camera data is shared by all packets of a view and is
+	// looked up by the view index, which is also the top of the sort key.
+
+	enum class PacketType : uint16
+	{
+		DRAW_SPRITE,
+		DRAW_TEXT,
+		DRAW_MESH
+	};
+
+	struct DrawSpritePacket
+	{
+		static const PacketType TYPE = PacketType::DRAW_SPRITE;
+
+		Pipeline* pipeline;
+		Texture* texture;	/**< Nullptr to draw without a texture. */
+		uint32 view;
+		math::mat4 MVP;
+		math::vec4 color;
+	};
+
+	/** \brief Draws a string, the characters are stored in the arena with RenderQueue::pushData. */
+	struct DrawTextPacket
+	{
+		static const PacketType TYPE = PacketType::DRAW_TEXT;
+
+		Font* font;
+		uint32 textOffset;	/**< Arena offset of the characters. */
+		uint32 textLength;
+		uint32 view;
+		math::mat4 matrix;
+		math::vec3 scale;
+		math::vec4 color;
+	};
+
+	/** \brief Draws one mesh of a model with its material. */
+	struct DrawMeshPacket
+	{
+		static const PacketType TYPE = PacketType::DRAW_MESH;
+
+		Pipeline* pipeline;
+		Buffer* vertexBuffer;
+		Buffer* indexBuffer;
+		Texture* diffuseTexture;
+		Texture* normalTexture;
+		Texture* specularTexture;
+		CubeMap* cubeMap;
+		uint32 indexCount;
+		IndexFormat indexFormat;
+		float shininess;
+		float glossyness;
+		uint32 view;
+		math::mat4 model;
+	};
+}
@@ -1,40 +1,184 @@
 #pragma once
 
+#include <cstring>
+#include <memory>
+#include <type_traits>
 #include <vector>
-#include <functional>
 #include "Core/Assert.h"
 #include "Renderer/RenderCommand.h"
+#include "Renderer/RenderPackets.h"
 
 namespace sge
 {
-	class GraphicsDevice;
+	class ThreadPool;
 
+	/** \brief Sortable list of render packets.
+	*
+	* Packets are copied into a linear arena that keeps its memory between frames, so pushing
+	* doesn't allocate once the arena has grown to its working size. Sorting only moves the
+	* compact (key, offset) items, the packets stay where they were written.
+	*
+	* The queue is split into segments that each have their own items and arena. Each recording
+	* thread pushes into a segment of its own, so no locks are needed. end() merges the segments
+	* and sorts the items with a radix sort on the keys, spread over the thread pool if one is set.
+	*
+	* queue.push<DrawSpritePacket>(key) = packet;
+	*
+	* for (auto& item : queue.getItems())
+	*     switch (item.type) { case PacketType::DRAW_SPRITE: draw(queue.getPacket<DrawSpritePacket>(item)); ... }
+	*/
 	class RenderQueue
 	{
 	public:
-		using RenderFunction = std::function<void(GraphicsDevice*)>;
-		using Queue = std::vector<std::pair<RenderCommand, RenderFunction>>;
+		struct Item
+		{
+			uint64 key;
+			uint32 offset;		/**< Arena offset of the packet. */
+			PacketType type;
+			uint16 segment;		/**< Segment whose arena holds the packet. */
+		};
+
+		/** \brief Items and packets recorded by a single thread. */
+		class Segment
+		{
+		public:
+			/** \brief Adds a packet of type P.
+			*
+			* \param const RenderCommand command : Sort key.
+			* \return The new packet, valid until the next push to this segment.
+			*/
+			template <typename P>
+			inline P& push(const RenderCommand command)
+			{
+				static_assert(std::is_trivially_copyable<P>::value, "Render packets must be plain data.");
+
+				SGE_ASSERT(*acceptingCommands);
+
+				uint32 offset = allocate(sizeof(P));
+
+				Item item = { command.bits, offset, P::TYPE, index };
+				items.push_back(item);
+
+				return *reinterpret_cast<P*>(&arena[offset]);
+			}
+
+			/** \brief Copies extra data for a packet into the arena, e.g. the characters of a text.
+			*
+			* \return Arena offset of the data, store it in the packet.
+			*/
+			inline uint32 pushData(const void* data, size_t size)
+			{
+				SGE_ASSERT(*acceptingCommands);
+
+				uint32 offset = allocate(size);
+				std::memcpy(arena.data() + offset, data, size);
+
+				return offset;
+			}
 
-		RenderQueue(size_t size);
+		private:
+			friend class RenderQueue;
+
+			Segment(size_t size, uint16 index, const bool* acceptingCommands);
+
+			/** \brief Reserves aligned room at the end of the arena. */
+			uint32 allocate(size_t size)
+			{
+				const size_t alignment = 16;
+				size_t offset = (arena.size() + alignment - 1) & ~(alignment - 1);
+
+				arena.resize(offset + size);
+
+				return static_cast<uint32>(offset);
+			}
+
+			std::vector<Item> items;
+			std::vector<char> arena;
+			const bool* acceptingCommands;
+			uint16 index;
+		};
+
+		/** \brief The constructor.
+		*
+		* \param size_t size : Number of items to reserve room for in each segment.
+		* \param size_t segmentCount : Number of threads that can record at the same time.
+		*/
+		RenderQueue(size_t size, size_t segmentCount = 1);
 
 		void begin();
 		void end();
 		void sort();
 		void clear();
 
-		inline const Queue& getQueue() const
-		{ 
-			return queue; 
+		/** \brief Sets the pool the sort is spread over. Null sorts on the calling thread. */
+		void setThreadPool(ThreadPool* pool)
+		{
+			this->pool = pool;
+		}
+
+		/** \brief Changes the number of segments. Not allowed between begin() and end(). */
+		void setSegmentCount(size_t count);
+
+		size_t getSegmentCount() const
+		{
+			return segments.size();
+		}
+
+		/** \brief Segment for a recording thread, e.g. the index of a ThreadPool::dispatch task.
+		*
+		* Every thread recording between begin() and end() must use a different segment.
+		*/
+		inline Segment& getSegment(size_t index)
+		{
+			SGE_ASSERT(index < segments.size());
+
+			return *segments[index];
+		}
+
+		/** \brief Sorted items after end(). */
+		inline const std::vector<Item>& getItems() const
+		{
+			return items;
+		}
+
+		/** \brief Adds a packet of type P to the first segment. */
+		template <typename P>
+		inline P& push(const RenderCommand command)
+		{
+			return segments[0]->push<P>(command);
 		}
-		
-		inline void push(const RenderCommand command, RenderFunction renderFunction)
+
+		/** \brief Copies extra data into the arena of the first segment. */
+		inline uint32 pushData(const void* data, size_t size)
+		{
+			return segments[0]->pushData(data, size);
+		}
+
+		template <typename P>
+		inline const P& getPacket(const Item& item) const
 		{
-            SGE_ASSERT(acceptingCommands);
+			SGE_ASSERT(item.type == P::TYPE);
 
-			queue.emplace_back(std::make_pair(command, renderFunction));
+			return *reinterpret_cast<const P*>(&segments[item.segment]->arena[item.offset]);
 		}
+
+		/** \brief Extra data stored with pushData in the same segment as the item's packet. */
+		inline const char* getData(const Item& item, uint32 offset) const
+		{
+			return segments[item.segment]->arena.data() + offset;
+		}
+
 	private:
-		Queue queue;
+		/** \brief Stable LSD radix sort of items by key, one pass per byte that isn't equal in every key. */
+		void radixSort();
+
+		// Each segment is allocated separately so recording threads don't share cache lines.
+		std::vector<std::unique_ptr<Segment>> segments;
+		std::vector<Item> items;
+		std::vector<Item> scratch;			/**< Second buffer of the radix sort. */
+		std::vector<size_t> histograms;		/**< Byte counts of each sort chunk. */
+		ThreadPool* pool;
+		size_t size;
 		bool acceptingCommands;
 	};
-}
\ No newline at end of file
+}
@@ -7,7 +7,14 @@ namespace sge
 	class Window
 	{
 	public:
-		Window(const char* title, int x, int y, int width, int height);
+		/** \brief The constructor.
+		*
+		* A headless window creates no SDL window, so nothing is shown and graphics devices
+		* created for it have no context. Used to run without a display or GPU.
+		* \param bool headless : True for a headless window.
+		*/
+		Window(const char* title, int x, int y, int width, int height, bool headless = false);
+
 		~Window();
 
 		SDL_Window* getSDLWindow();
@@ -21,9 +28,15 @@ namespace sge
 			return height;
 		}
 
+		bool isHeadless() const
+		{
+			return headless;
+		}
+
 	private:
 		SDL_Window* window;
 		int width;
 		int height;
+		bool headless;
 	};
 }
\ No newline at end of file
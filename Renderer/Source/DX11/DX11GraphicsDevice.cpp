@@ -49,8 +49,23 @@ namespace sge
 			pipeline(nullptr),
 			backBufferTexture(NULL),
 			depthStencilBuffer(NULL),
-			depthStencilView(NULL)
+			depthStencilView(NULL),
+			boundPipeline(nullptr),
+			vertexBuffer(NULL),
+			indexBuffer(NULL),
+			indexFormat(DXGI_FORMAT_UNKNOWN),
+			viewportValid(false)
 		{
+			for (size_t i = 0; i < MAX_SLOTS; i++)
+			{
+				vertexConstantBuffers[i] = NULL;
+				pixelConstantBuffers[i] = NULL;
+				shaderResources[i] = NULL;
+			}
+
+			counters.issued = 0;
+			counters.skipped = 0;
+
 			// Get windows handle from SDL.
 			SDL_SysWMinfo info;
 
@@ -74,6 +89,16 @@ namespace sge
 		{
 		}
 
+		/** \brief Counts a state change, returns true if it has to be sent to the context. */
+		bool countChange(bool changed)
+		{
+			changed ? counters.issued++ : counters.skipped++;
+
+			return changed;
+		}
+
+		static const size_t MAX_SLOTS = D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT;
+
 		Window& window;
 		HDC hdc;
 		HWND hwnd;
@@ -87,6 +112,19 @@ namespace sge
 		ID3D11DepthStencilView* depthStencilView;
         DX11RenderTarget* currentRenderTarget;
         DX11RenderTarget* defaultRenderTarget;
+
+		// State last set on the context, binds of the same state are skipped.
+		DX11Pipeline* boundPipeline;
+		ID3D11Buffer* vertexBuffer;
+		ID3D11Buffer* indexBuffer;
+		DXGI_FORMAT indexFormat;
+		ID3D11Buffer* vertexConstantBuffers[MAX_SLOTS];
+		ID3D11Buffer* pixelConstantBuffers[MAX_SLOTS];
+		ID3D11ShaderResourceView* shaderResources[MAX_SLOTS];
+		Viewport viewport;
+		bool viewportValid;
+
+		StateCounters counters;
 	};
 
 	GraphicsDevice::GraphicsDevice(Window& window) :
@@ -191,6 +229,17 @@ namespace sge
         bindRenderTarget(&impl->defaultRenderTarget->header);
 	}
 
+	const GraphicsDevice::StateCounters& GraphicsDevice::getStateCounters() const
+	{
+		return impl->counters;
+	}
+
+	void GraphicsDevice::resetStateCounters()
+	{
+		impl->counters.issued = 0;
+		impl->counters.skipped = 0;
+	}
+
 	void GraphicsDevice::deinit()
 	{
 		// Set fullscreen to false before releasing the swap chain.
@@ -273,10 +322,52 @@ namespace sge
 		DX11Buffer* dx11Buffer = reinterpret_cast<DX11Buffer*>(buffer);
 		dx11Buffer->buffer->Release();
 
+		delete[] dx11Buffer->streamData;
 		delete dx11Buffer;
 		buffer = nullptr;
 	}
 
+	Buffer* GraphicsDevice::createStreamBuffer(size_t size)
+	{
+		DX11Buffer* dx11Buffer = new DX11Buffer();
+
+		// Ranges are uploaded to the start of the buffer, so it only needs room for the largest cbuffer.
+		const size_t maxSize = D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT * 16;
+
+		D3D11_BUFFER_DESC bd;
+		ZeroMemory(&bd, sizeof(bd));
+		bd.Usage = D3D11_USAGE_DYNAMIC;
+		bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		bd.ByteWidth = static_cast<UINT>(size < maxSize ? size : maxSize);
+
+		impl->device->CreateBuffer(&bd, NULL, &dx11Buffer->buffer);
+
+		dx11Buffer->streamData = new char[size];
+		dx11Buffer->header.size = size;
+
+		return &dx11Buffer->header;
+	}
+
+	void* GraphicsDevice::allocateStreamData(Buffer* buffer, size_t size, size_t& offset)
+	{
+		DX11Buffer* dx11Buffer = reinterpret_cast<DX11Buffer*>(buffer);
+
+		SGE_ASSERT(dx11Buffer->streamData && size <= dx11Buffer->header.size);
+
+		// The copy isn't read by the GPU, it can be reused right away.
+		offset = (dx11Buffer->streamHead + 15) & ~static_cast<size_t>(15);
+
+		if (offset + size > dx11Buffer->header.size)
+		{
+			offset = 0;
+		}
+
+		dx11Buffer->streamHead = offset + size;
+
+		return dx11Buffer->streamData + offset;
+	}
+
 	Pipeline* GraphicsDevice::createPipeline(VertexLayoutDescription* vertexLayoutDescription, Shader* vertexShader, Shader* pixelShader)
 	{
 		DX11Pipeline* dx11Pipeline = new DX11Pipeline();
@@ -463,6 +554,11 @@ namespace sge
 		dx11Pipeline->depthStencilState->Release();
 		dx11Pipeline->blendState->Release();
 
+		if (impl->boundPipeline == dx11Pipeline)
+		{
+			impl->boundPipeline = nullptr;
+		}
+
 		delete dx11Pipeline->vertexLayout;
 		delete dx11Pipeline;
 
@@ -638,6 +734,37 @@ namespace sge
 		return &dx11Texture->header;
 	}
 
+	void GraphicsDevice::copyTextTextureData(Texture* texture, size_t x, size_t y, size_t width, size_t height, const unsigned char* source)
+	{
+		// Text textures aren't supported yet, see createTextTexture.
+		if (texture == nullptr)
+		{
+			return;
+		}
+
+		DX11Texture* dx11Texture = reinterpret_cast<DX11Texture*>(texture);
+
+		D3D11_BOX box;
+		box.left = static_cast<UINT>(x);
+		box.top = static_cast<UINT>(y);
+		box.front = 0;
+		box.right = static_cast<UINT>(x + width);
+		box.bottom = static_cast<UINT>(y + height);
+		box.back = 1;
+
+		impl->context->UpdateSubresource(dx11Texture->texture, 0, &box, source, static_cast<UINT>(width), 0);
+	}
+
+	void GraphicsDevice::generateMipmaps(Texture* texture)
+	{
+		if (texture == nullptr)
+		{
+			return;
+		}
+
+		impl->context->GenerateMips(reinterpret_cast<DX11Texture*>(texture)->view);
+	}
+
 	void GraphicsDevice::deleteTexture(Texture* texture)
 	{
 		DX11Texture* dx11Texture = reinterpret_cast<DX11Texture*>(texture);
@@ -652,6 +779,15 @@ namespace sge
 	void GraphicsDevice::bindPipeline(Pipeline* pipeline)
 	{
 		DX11Pipeline* dx11Pipeline = reinterpret_cast<DX11Pipeline*>(pipeline);
+
+		impl->pipeline = dx11Pipeline;
+
+		if (!impl->countChange(impl->boundPipeline != dx11Pipeline))
+		{
+			return;
+		}
+
+		impl->boundPipeline = dx11Pipeline;
 		impl->context->IASetInputLayout(dx11Pipeline->vertexLayout->inputLayout);
 		impl->context->VSSetShader(dx11Pipeline->vertexShader->vertexShader, 0, 0);
 		impl->context->PSSetShader(dx11Pipeline->pixelShader->pixelShader, 0, 0);
@@ -660,8 +796,6 @@ namespace sge
 		impl->context->RSSetState(dx11Pipeline->rasterizerState);
 		impl->context->OMSetDepthStencilState(dx11Pipeline->depthStencilState, 0);
 		impl->context->OMSetBlendState(dx11Pipeline->blendState, NULL, 0xffffffff);
-
-		impl->pipeline = dx11Pipeline;
 	}
 
 	void GraphicsDevice::debindPipeline(Pipeline* pipeline)
@@ -686,6 +820,13 @@ namespace sge
 	{
 		DX11Buffer* dx11Buffer = reinterpret_cast<DX11Buffer*>(buffer);
 
+		if (!impl->countChange(impl->vertexBuffer != dx11Buffer->buffer))
+		{
+			return;
+		}
+
+		impl->vertexBuffer = dx11Buffer->buffer;
+
 		// TODO do we really need to do this?
 		UINT stride = impl->pipeline->vertexLayout->header.stride * sizeof(float);
 		UINT offset = 0;
@@ -693,23 +834,83 @@ namespace sge
 		impl->context->IASetVertexBuffers(0, 1, &dx11Buffer->buffer, &stride, &offset);
 	}
 
-	void GraphicsDevice::bindIndexBuffer(Buffer* buffer)
+	void GraphicsDevice::bindIndexBuffer(Buffer* buffer, IndexFormat format)
 	{
-		impl->context->IASetIndexBuffer(reinterpret_cast<DX11Buffer*>(buffer)->buffer, DXGI_FORMAT_R32_UINT, 0);
+		ID3D11Buffer* dx11Buffer = reinterpret_cast<DX11Buffer*>(buffer)->buffer;
+		DXGI_FORMAT dxgiFormat = format == IndexFormat::UINT16 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+
+		if (impl->countChange(impl->indexBuffer != dx11Buffer || impl->indexFormat != dxgiFormat))
+		{
+			impl->indexBuffer = dx11Buffer;
+			impl->indexFormat = dxgiFormat;
+			impl->context->IASetIndexBuffer(dx11Buffer, dxgiFormat, 0);
+		}
 	}
 
 	void GraphicsDevice::bindVertexUniformBuffer(Buffer* buffer, size_t slot)
 	{
-		impl->context->VSSetConstantBuffers(slot, 1, &reinterpret_cast<DX11Buffer*>(buffer)->buffer);
+		SGE_ASSERT(slot < Impl::MAX_SLOTS);
+
+		ID3D11Buffer* dx11Buffer = reinterpret_cast<DX11Buffer*>(buffer)->buffer;
+
+		if (impl->countChange(impl->vertexConstantBuffers[slot] != dx11Buffer))
+		{
+			impl->vertexConstantBuffers[slot] = dx11Buffer;
+			impl->context->VSSetConstantBuffers(slot, 1, &dx11Buffer);
+		}
 	}
 
 	void GraphicsDevice::bindPixelUniformBuffer(Buffer* buffer, size_t slot)
 	{
-		impl->context->PSSetConstantBuffers(slot, 1, &reinterpret_cast<DX11Buffer*>(buffer)->buffer);
+		SGE_ASSERT(slot < Impl::MAX_SLOTS);
+
+		ID3D11Buffer* dx11Buffer = reinterpret_cast<DX11Buffer*>(buffer)->buffer;
+
+		if (impl->countChange(impl->pixelConstantBuffers[slot] != dx11Buffer))
+		{
+			impl->pixelConstantBuffers[slot] = dx11Buffer;
+			impl->context->PSSetConstantBuffers(slot, 1, &dx11Buffer);
+		}
+	}
+
+	void GraphicsDevice::bindVertexUniformBuffer(Buffer* buffer, size_t slot, size_t offset, size_t size)
+	{
+		DX11Buffer* dx11Buffer = reinterpret_cast<DX11Buffer*>(buffer);
+
+		D3D11_MAPPED_SUBRESOURCE ms;
+		impl->context->Map(dx11Buffer->buffer, NULL, D3D11_MAP_WRITE_DISCARD, NULL, &ms);
+		memcpy(ms.pData, dx11Buffer->streamData + offset, size);
+		impl->context->Unmap(dx11Buffer->buffer, NULL);
+
+		bindVertexUniformBuffer(buffer, slot);
+	}
+
+	void GraphicsDevice::bindPixelUniformBuffer(Buffer* buffer, size_t slot, size_t offset, size_t size)
+	{
+		DX11Buffer* dx11Buffer = reinterpret_cast<DX11Buffer*>(buffer);
+
+		D3D11_MAPPED_SUBRESOURCE ms;
+		impl->context->Map(dx11Buffer->buffer, NULL, D3D11_MAP_WRITE_DISCARD, NULL, &ms);
+		memcpy(ms.pData, dx11Buffer->streamData + offset, size);
+		impl->context->Unmap(dx11Buffer->buffer, NULL);
+
+		bindPixelUniformBuffer(buffer, slot);
 	}
 
-	void GraphicsDevice::bindViewport(Viewport* viewport)
+	void GraphicsDevice::bindViewport(const Viewport* viewport)
 	{
+		bool changed = !impl->viewportValid ||
+			impl->viewport.x != viewport->x || impl->viewport.y != viewport->y ||
+			impl->viewport.width != viewport->width || impl->viewport.height != viewport->height;
+
+		if (!impl->countChange(changed))
+		{
+			return;
+		}
+
+		impl->viewport = *viewport;
+		impl->viewportValid = true;
+
 		D3D11_VIEWPORT d11Viewport;
 		ZeroMemory(&d11Viewport, sizeof(D3D11_VIEWPORT));
 
@@ -725,19 +926,38 @@ namespace sge
 
 	void GraphicsDevice::bindTexture(Texture* texture, size_t slot)
 	{
-        impl->context->PSSetShaderResources(slot, 1, &reinterpret_cast<DX11Texture*>(texture)->view);
+		SGE_ASSERT(slot < Impl::MAX_SLOTS);
+
+		ID3D11ShaderResourceView* view = reinterpret_cast<DX11Texture*>(texture)->view;
+
+		if (impl->countChange(impl->shaderResources[slot] != view))
+		{
+			impl->shaderResources[slot] = view;
+			impl->context->PSSetShaderResources(slot, 1, &view);
+		}
 	}
 
 	void GraphicsDevice::debindTexture(Texture* texture, size_t slot)
 	{
-        ID3D11ShaderResourceView* tab[] = { NULL };
-        impl->context->PSSetShaderResources(slot, 1, tab);
+		SGE_ASSERT(slot < Impl::MAX_SLOTS);
+
+		if (impl->countChange(impl->shaderResources[slot] != NULL))
+		{
+			ID3D11ShaderResourceView* tab[] = { NULL };
+			impl->shaderResources[slot] = NULL;
+			impl->context->PSSetShaderResources(slot, 1, tab);
+		}
 	}
 
 	void GraphicsDevice::copyData(Buffer* buffer, size_t size, const void* data)
 	{
 		DX11Buffer* dx11Buffer = reinterpret_cast<DX11Buffer*>(buffer);
 
+		if (data == nullptr)
+		{
+			return;
+		}
+
 		D3D11_MAPPED_SUBRESOURCE ms;
 		impl->context->Map(dx11Buffer->buffer, NULL, D3D11_MAP_WRITE_DISCARD, NULL, &ms);
 		memcpy(ms.pData, data, size);
@@ -746,7 +966,13 @@ namespace sge
 
 	void GraphicsDevice::copySubData(Buffer* buffer, size_t offset, size_t size, const void* data)
 	{
+		DX11Buffer* dx11Buffer = reinterpret_cast<DX11Buffer*>(buffer);
 
+		// Dynamic buffers can only be mapped as a whole, the data outside the range is discarded.
+		D3D11_MAPPED_SUBRESOURCE ms;
+		impl->context->Map(dx11Buffer->buffer, NULL, D3D11_MAP_WRITE_DISCARD, NULL, &ms);
+		memcpy(static_cast<char*>(ms.pData) + offset, data, size);
+		impl->context->Unmap(dx11Buffer->buffer, NULL);
 	}
 
 	void GraphicsDevice::draw(size_t count)
@@ -761,7 +987,7 @@ namespace sge
 
 	void GraphicsDevice::drawInstanced(size_t count, size_t instanceCount)
 	{
-
+		impl->context->DrawInstanced(count, instanceCount, 0, 0);
 	}
 
 	void GraphicsDevice::drawInstancedIndexed(size_t count, size_t instanceCount)
@@ -1,7 +1,9 @@
 #ifdef OPENGL4
 
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <vector>
 
 
 #include "SDL2/SDL.h"
@@ -21,6 +23,7 @@
 #include "Resources/TextureResource.h"
 
 #include "Core/Assert.h"
+#include "Core/Types.h"
 
 namespace sge
 {
@@ -45,11 +48,34 @@ namespace sge
 		}
 	}
 
+	const size_t MAX_TEXTURE_SLOTS = 16;
+	const size_t MAX_UNIFORM_SLOTS = 16;
+
+	// Binding that isn't known, e.g. the index buffer of a vertex array that was just bound.
+	const GLuint UNKNOWN_BINDING = ~0u;
+
 	struct GraphicsDevice::Impl
 	{
 		Impl(Window& window) :
-			window(window.getSDLWindow()), context(SDL_GL_CreateContext(window.getSDLWindow())), pipeline(nullptr)
+			window(window.getSDLWindow()), context(SDL_GL_CreateContext(window.getSDLWindow())), pipeline(nullptr),
+			program(0), vertexArray(0), activeTexture(0), arrayBuffer(0), elementBuffer(0), uniformBuffer(0),
+			attribVertexArray(0), attribBuffer(UNKNOWN_BINDING), viewportValid(false), uniformAlignment(256), indexType(GL_UNSIGNED_INT),
+			pendingProgram(0), pendingVertexArray(0), pendingTextureSlots(0), pendingCubeMapSlots(0), dirty(false)
 		{
+			for (size_t i = 0; i < MAX_TEXTURE_SLOTS; i++)
+			{
+				textures[i] = cubeMaps[i] = 0;
+				pendingTextures[i] = pendingCubeMaps[i] = 0;
+			}
+
+			for (size_t i = 0; i < MAX_UNIFORM_SLOTS; i++)
+			{
+				uniformSlots[i] = 0;
+				uniformOffsets[i] = uniformSizes[i] = 0;
+			}
+
+			counters.issued = 0;
+			counters.skipped = 0;
 		}
 
 		~Impl()
@@ -57,9 +83,314 @@ namespace sge
 			SDL_GL_DeleteContext(context);
 		}
 
+		// STATE CACHE
+		//
+		// The apply functions change the GL state right away and skip the call if the state is
+		// already set. Pipelines and textures are bound lazily: bind and debind only change the
+		// pending state, which is applied by flush() before a draw. Binding the same pipeline or
+		// texture again after a debind costs nothing.
+
+		bool countChange(bool changed)
+		{
+			changed ? counters.issued++ : counters.skipped++;
+
+			return changed;
+		}
+
+		void applyProgram(GLuint id)
+		{
+			if (countChange(program != id))
+			{
+				glUseProgram(id);
+				program = id;
+			}
+		}
+
+		void applyVertexArray(GLuint id)
+		{
+			if (countChange(vertexArray != id))
+			{
+				glBindVertexArray(id);
+				vertexArray = id;
+
+				// The index buffer binding is part of the vertex array.
+				elementBuffer = UNKNOWN_BINDING;
+			}
+		}
+
+		void applyTexture(size_t slot, GLenum target, GLuint id)
+		{
+			SGE_ASSERT(slot < MAX_TEXTURE_SLOTS);
+
+			GLuint& bound = target == GL_TEXTURE_CUBE_MAP ? cubeMaps[slot] : textures[slot];
+
+			if (countChange(bound != id))
+			{
+				if (countChange(activeTexture != slot))
+				{
+					glActiveTexture(GL_TEXTURE0 + slot);
+					activeTexture = slot;
+				}
+
+				glBindTexture(target, id);
+				bound = id;
+			}
+		}
+
+		void applyBuffer(GLenum target, GLuint id)
+		{
+			GLuint* bound = nullptr;
+
+			switch (target)
+			{
+			case GL_ARRAY_BUFFER: bound = &arrayBuffer; break;
+			case GL_ELEMENT_ARRAY_BUFFER: bound = &elementBuffer; break;
+			case GL_UNIFORM_BUFFER: bound = &uniformBuffer; break;
+			}
+
+			if (bound == nullptr)
+			{
+				glBindBuffer(target, id);
+				countChange(true);
+			}
+			else if (countChange(*bound != id))
+			{
+				glBindBuffer(target, id);
+				*bound = id;
+			}
+		}
+
+		void applyUniformBuffer(size_t slot, GLuint id)
+		{
+			SGE_ASSERT(slot < MAX_UNIFORM_SLOTS);
+
+			if (countChange(uniformSlots[slot] != id || uniformSizes[slot] != 0))
+			{
+				// Also binds the buffer to the GL_UNIFORM_BUFFER target.
+				glBindBufferBase(GL_UNIFORM_BUFFER, slot, id);
+				uniformSlots[slot] = id;
+				uniformOffsets[slot] = uniformSizes[slot] = 0;
+				uniformBuffer = id;
+			}
+		}
+
+		void applyUniformBufferRange(size_t slot, GLuint id, size_t offset, size_t size)
+		{
+			SGE_ASSERT(slot < MAX_UNIFORM_SLOTS && size != 0);
+
+			if (countChange(uniformSlots[slot] != id || uniformOffsets[slot] != offset || uniformSizes[slot] != size))
+			{
+				glBindBufferRange(GL_UNIFORM_BUFFER, slot, id, offset, size);
+				uniformSlots[slot] = id;
+				uniformOffsets[slot] = offset;
+				uniformSizes[slot] = size;
+				uniformBuffer = id;
+			}
+		}
+
+		void applyViewport(const Viewport& viewport)
+		{
+			bool changed = !viewportValid ||
+				this->viewport.x != viewport.x || this->viewport.y != viewport.y ||
+				this->viewport.width != viewport.width || this->viewport.height != viewport.height;
+
+			if (countChange(changed))
+			{
+				glViewport(viewport.x, viewport.y, viewport.width, viewport.height);
+				this->viewport = viewport;
+				viewportValid = true;
+			}
+		}
+
+		/** \brief Marks a texture slot as changed, flush() applies its pending textures. */
+		void touchTextureSlot(size_t slot, GLenum target)
+		{
+			SGE_ASSERT(slot < MAX_TEXTURE_SLOTS);
+
+			(target == GL_TEXTURE_CUBE_MAP ? pendingCubeMapSlots : pendingTextureSlots) |= 1u << slot;
+			dirty = true;
+		}
+
+		/** \brief Applies the pending pipeline and textures. */
+		void flush()
+		{
+			if (!dirty)
+			{
+				return;
+			}
+
+			applyProgram(pendingProgram);
+			applyVertexArray(pendingVertexArray);
+
+			for (size_t i = 0; i < MAX_TEXTURE_SLOTS; i++)
+			{
+				if (pendingTextureSlots & (1u << i))
+				{
+					applyTexture(i, GL_TEXTURE_2D, pendingTextures[i]);
+				}
+
+				if (pendingCubeMapSlots & (1u << i))
+				{
+					applyTexture(i, GL_TEXTURE_CUBE_MAP, pendingCubeMaps[i]);
+				}
+			}
+
+			pendingTextureSlots = 0;
+			pendingCubeMapSlots = 0;
+			dirty = false;
+		}
+
+		// GL unbinds deleted objects and may hand their names out again, so they are dropped from the cache.
+
+		void forgetBuffer(GLuint id)
+		{
+			GLuint* bindings[] = { &arrayBuffer, &elementBuffer, &uniformBuffer };
+
+			for (auto binding : bindings)
+			{
+				if (*binding == id)
+				{
+					*binding = 0;
+				}
+			}
+
+			for (size_t i = 0; i < MAX_UNIFORM_SLOTS; i++)
+			{
+				if (uniformSlots[i] == id)
+				{
+					uniformSlots[i] = 0;
+				}
+			}
+
+			if (attribBuffer == id)
+			{
+				attribBuffer = UNKNOWN_BINDING;
+			}
+		}
+
+		void forgetTexture(GLuint id)
+		{
+			for (size_t i = 0; i < MAX_TEXTURE_SLOTS; i++)
+			{
+				if (textures[i] == id) textures[i] = 0;
+				if (pendingTextures[i] == id) pendingTextures[i] = 0;
+				if (cubeMaps[i] == id) cubeMaps[i] = 0;
+				if (pendingCubeMaps[i] == id) pendingCubeMaps[i] = 0;
+			}
+		}
+
+		void forgetPipeline(GL4Pipeline* gl4Pipeline)
+		{
+			if (program == gl4Pipeline->program) program = 0;
+			if (pendingProgram == gl4Pipeline->program) pendingProgram = 0;
+
+			if (vertexArray == gl4Pipeline->vao)
+			{
+				vertexArray = 0;
+				elementBuffer = UNKNOWN_BINDING;
+			}
+
+			if (pendingVertexArray == gl4Pipeline->vao) pendingVertexArray = 0;
+			if (attribVertexArray == gl4Pipeline->vao) attribBuffer = UNKNOWN_BINDING;
+			if (pipeline == gl4Pipeline) pipeline = nullptr;
+		}
+
+		// STREAM BUFFERS
+
+		void createStreamStorage(GL4Buffer* buffer, size_t regionSize)
+		{
+			const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+			buffer->header.size = regionSize * STREAM_REGIONS;
+
+			glGenBuffers(1, &buffer->id);
+			applyBuffer(GL_UNIFORM_BUFFER, buffer->id);
+			glBufferStorage(GL_UNIFORM_BUFFER, buffer->header.size, nullptr, flags);
+			buffer->mapped = static_cast<char*>(glMapBufferRange(GL_UNIFORM_BUFFER, 0, buffer->header.size, flags));
+			buffer->streamHead = buffer->streamRegion * regionSize;
+
+			checkError();
+		}
+
+		void deleteStreamFences(GL4Buffer* buffer)
+		{
+			for (auto& fence : buffer->fences)
+			{
+				if (fence)
+				{
+					glDeleteSync(fence);
+					fence = nullptr;
+				}
+			}
+		}
+
+		// Draws recorded with the old storage keep it alive until the GPU is done with them. Nothing reads
+		// the new storage yet, so the fences of the old one are dropped.
+
+		void growStreamBuffer(GL4Buffer* buffer, size_t regionSize)
+		{
+			deleteStreamFences(buffer);
+
+			glDeleteBuffers(1, &buffer->id);
+			forgetBuffer(buffer->id);
+
+			createStreamStorage(buffer, regionSize);
+		}
+
+		// Fences the region the frame wrote and moves on, the region is written again STREAM_REGIONS frames later.
+
+		void endStreamFrame(GL4Buffer* buffer)
+		{
+			size_t regionSize = buffer->header.size / STREAM_REGIONS;
+			GLsync& fence = buffer->fences[buffer->streamRegion];
+
+			// Left over if the frame wrote nothing.
+			if (fence)
+			{
+				glDeleteSync(fence);
+			}
+
+			fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+			buffer->streamRegion = (buffer->streamRegion + 1) % STREAM_REGIONS;
+			buffer->streamHead = buffer->streamRegion * regionSize;
+		}
+
 		SDL_Window* window;
 		SDL_GLContext context;
 		GL4Pipeline* pipeline;
+		std::vector<GL4Buffer*> streamBuffers;
+
+		// Current GL state.
+		GLuint program;
+		GLuint vertexArray;
+		size_t activeTexture;
+		GLuint textures[MAX_TEXTURE_SLOTS];
+		GLuint cubeMaps[MAX_TEXTURE_SLOTS];
+		GLuint arrayBuffer;
+		GLuint elementBuffer;
+		GLuint uniformBuffer;
+		GLuint uniformSlots[MAX_UNIFORM_SLOTS];
+		size_t uniformOffsets[MAX_UNIFORM_SLOTS];
+		size_t uniformSizes[MAX_UNIFORM_SLOTS];		/**< Zero if the whole buffer is bound. */
+		GLuint attribVertexArray;	/**< Vertex array whose attributes were last set up. */
+		GLuint attribBuffer;		/**< Vertex buffer the attributes were set up for. */
+		Viewport viewport;
+		bool viewportValid;
+
+		GLint uniformAlignment;		/**< Required alignment of uniform buffer range offsets. */
+		GLenum indexType;			/**< Type of the indices in the bound index buffer. */
+
+		// State requested by the binds, applied by flush().
+		GLuint pendingProgram;
+		GLuint pendingVertexArray;
+		GLuint pendingTextures[MAX_TEXTURE_SLOTS];
+		GLuint pendingCubeMaps[MAX_TEXTURE_SLOTS];
+		uint32 pendingTextureSlots;		/**< Bit per slot whose texture was bound or debound since the last flush. */
+		uint32 pendingCubeMapSlots;
+		bool dirty;
+
+		StateCounters counters;
 	};
 
 	GraphicsDevice::GraphicsDevice(Window& window) :
@@ -84,6 +415,8 @@ namespace sge
 		glGetIntegerv(GL_MINOR_VERSION, &minor);
 
 		std::cout << "Using OpenGL version " << major << "." << minor << std::endl;
+
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &impl->uniformAlignment);
 		
 		glEnable(GL_CULL_FACE);
 		glEnable(GL_DEPTH_TEST);
@@ -100,8 +433,24 @@ namespace sge
 
 	}
 
+	const GraphicsDevice::StateCounters& GraphicsDevice::getStateCounters() const
+	{
+		return impl->counters;
+	}
+
+	void GraphicsDevice::resetStateCounters()
+	{
+		impl->counters.issued = 0;
+		impl->counters.skipped = 0;
+	}
+
 	void GraphicsDevice::swap()
 	{
+		for (auto buffer : impl->streamBuffers)
+		{
+			impl->endStreamFrame(buffer);
+		}
+
 		SDL_GL_SwapWindow(impl->window);
 	}
 
@@ -141,7 +490,17 @@ namespace sge
 	{
 		GL4Buffer* gl4Buffer = reinterpret_cast<GL4Buffer*>(buffer);
 
+		if (gl4Buffer->mapped)
+		{
+			auto& streamBuffers = impl->streamBuffers;
+			streamBuffers.erase(std::find(streamBuffers.begin(), streamBuffers.end(), gl4Buffer));
+		}
+
+		impl->deleteStreamFences(gl4Buffer);
+
+		// Deleting a buffer unmaps it.
 		glDeleteBuffers(1, &gl4Buffer->id);
+		impl->forgetBuffer(gl4Buffer->id);
 
 		checkError();
 
@@ -149,6 +508,66 @@ namespace sge
 		buffer = nullptr;
 	}
 
+	Buffer* GraphicsDevice::createStreamBuffer(size_t size)
+	{
+		GL4Buffer* buffer = new GL4Buffer();
+
+		buffer->target = GL_UNIFORM_BUFFER;
+		buffer->usage = GL_DYNAMIC_DRAW;
+
+		// Regions start at an aligned offset.
+		size_t alignment = impl->uniformAlignment;
+		size_t regionSize = (size + alignment - 1) / alignment * alignment;
+
+		SGE_ASSERT(regionSize > 0);
+
+		impl->createStreamStorage(buffer, regionSize);
+		impl->streamBuffers.push_back(buffer);
+
+		return &buffer->header;
+	}
+
+	void* GraphicsDevice::allocateStreamData(Buffer* buffer, size_t size, size_t& offset)
+	{
+		GL4Buffer* gl4Buffer = reinterpret_cast<GL4Buffer*>(buffer);
+
+		size_t alignment = impl->uniformAlignment;
+		size_t regionSize = gl4Buffer->header.size / STREAM_REGIONS;
+
+		SGE_ASSERT(gl4Buffer->mapped);
+
+		GLsync& fence = gl4Buffer->fences[gl4Buffer->streamRegion];
+
+		// The first write of a frame waits for the GPU to finish the frame that used the region before.
+		if (fence)
+		{
+			while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED)
+			{
+			}
+
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+
+		offset = (gl4Buffer->streamHead + alignment - 1) / alignment * alignment;
+
+		if (offset + size > (gl4Buffer->streamRegion + 1) * regionSize)
+		{
+			// The frame outgrew its region. Wrapping would overwrite ranges this frame still draws with,
+			// so the buffer grows instead and keeps the larger size from then on.
+			size_t used = offset - gl4Buffer->streamRegion * regionSize;
+			size_t grownSize = std::max(regionSize * 2, (used + size + alignment - 1) / alignment * alignment);
+
+			impl->growStreamBuffer(gl4Buffer, grownSize);
+
+			offset = gl4Buffer->streamHead;
+		}
+
+		gl4Buffer->streamHead = offset + size;
+
+		return gl4Buffer->mapped + offset;
+	}
+
 	Pipeline* GraphicsDevice::createPipeline(VertexLayoutDescription* vertexLayoutDescription, Shader* vertexShader, Shader* pixelShader)
 	{
 		GL4Pipeline* gl4Pipeline = new GL4Pipeline();
@@ -156,7 +575,7 @@ namespace sge
 		GL4Shader* gl4PixelShader = reinterpret_cast<GL4Shader*>(pixelShader);
 
 		glGenVertexArrays(1, &gl4Pipeline->vao);
-		glBindVertexArray(gl4Pipeline->vao);
+		impl->applyVertexArray(gl4Pipeline->vao);
 
 		GLint success;
 		GLchar infoLog[512];
@@ -219,7 +638,8 @@ namespace sge
 
 		std::cout << "Active uniform blocks: " << numberOfUniformBlocks << std::endl;
 
-		glBindVertexArray(0);
+		impl->applyVertexArray(0);
+		impl->dirty = true;
 
 		checkError();
 
@@ -231,6 +651,7 @@ namespace sge
 		GL4Pipeline* gl4Pipeline = reinterpret_cast<GL4Pipeline*>(pipeline);
 		glDeleteProgram(gl4Pipeline->program);
 		glDeleteVertexArrays(1, &gl4Pipeline->vao);
+		impl->forgetPipeline(gl4Pipeline);
 
 		checkError();
 
@@ -348,7 +769,7 @@ namespace sge
         glGenTextures(1, &gl4Texture->id);
         checkError();
 
-        glBindTexture(GL_TEXTURE_2D, gl4Texture->id);
+        impl->applyTexture(0, GL_TEXTURE_2D, gl4Texture->id);
 
         checkError();
 
@@ -378,7 +799,8 @@ namespace sge
         glGenerateMipmap(GL_TEXTURE_2D);
 
         checkError();
-        glBindTexture(GL_TEXTURE_2D, 0);
+        impl->applyTexture(0, GL_TEXTURE_2D, 0);
+        impl->touchTextureSlot(0, GL_TEXTURE_2D);
 
         checkError();
 
@@ -392,7 +814,7 @@ namespace sge
         glGenTextures(1, &gl4Texture->id);
         checkError();
 
-        glBindTexture(GL_TEXTURE_2D, gl4Texture->id);
+        impl->applyTexture(0, GL_TEXTURE_2D, gl4Texture->id);
         checkError();
 
         float maxValue;
@@ -413,7 +835,8 @@ namespace sge
         glGenerateMipmap(GL_TEXTURE_2D);
 
         checkError();
-        glBindTexture(GL_TEXTURE_2D, 0);
+        impl->applyTexture(0, GL_TEXTURE_2D, 0);
+        impl->touchTextureSlot(0, GL_TEXTURE_2D);
 
         checkError();
 
@@ -430,10 +853,32 @@ namespace sge
         return createTextTexture(source->getSize().x, source->getSize().y, source->getData());
     }
 
+    void GraphicsDevice::copyTextTextureData(Texture* texture, size_t x, size_t y, size_t width, size_t height, const unsigned char* source)
+    {
+        impl->applyTexture(0, GL_TEXTURE_2D, reinterpret_cast<GL4Texture*>(texture)->id);
+        impl->touchTextureSlot(0, GL_TEXTURE_2D);
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RED, GL_UNSIGNED_BYTE, source);
+
+        checkError();
+    }
+
+    void GraphicsDevice::generateMipmaps(Texture* texture)
+    {
+        impl->applyTexture(0, GL_TEXTURE_2D, reinterpret_cast<GL4Texture*>(texture)->id);
+        impl->touchTextureSlot(0, GL_TEXTURE_2D);
+
+        glGenerateMipmap(GL_TEXTURE_2D);
+
+        checkError();
+    }
+
     void GraphicsDevice::deleteTexture(Texture* texture)
     {
         GL4Texture* gl4Texture = reinterpret_cast<GL4Texture*>(texture);
         glDeleteTextures(1, &gl4Texture->id);
+        impl->forgetTexture(gl4Texture->id);
 
         checkError();
 
@@ -446,7 +891,7 @@ namespace sge
         GL4CubeMap* gl4CubeMap = new GL4CubeMap();
 
         glGenTextures(1, &gl4CubeMap->id);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, gl4CubeMap->id);
+        impl->applyTexture(0, GL_TEXTURE_CUBE_MAP, gl4CubeMap->id);
 
 		for (size_t i = 0; i < 6; i++)
 		{
@@ -461,7 +906,8 @@ namespace sge
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
-		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		impl->applyTexture(0, GL_TEXTURE_CUBE_MAP, 0);
+		impl->touchTextureSlot(0, GL_TEXTURE_CUBE_MAP);
 
 		return &gl4CubeMap->header;
 	}
@@ -479,20 +925,19 @@ namespace sge
 	void GraphicsDevice::bindPipeline(Pipeline* pipeline)
 	{
 		GL4Pipeline* gl4Pipeline = reinterpret_cast<GL4Pipeline*>(pipeline);
-		glUseProgram(gl4Pipeline->program);
-		glBindVertexArray(gl4Pipeline->vao);
 
-		checkError();
+		impl->pendingProgram = gl4Pipeline->program;
+		impl->pendingVertexArray = gl4Pipeline->vao;
+		impl->dirty = true;
 
 		impl->pipeline = gl4Pipeline;
 	}
 
 	void GraphicsDevice::debindPipeline(Pipeline* pipeline)
 	{
-		glUseProgram(0);
-		glBindVertexArray(0);
-
-		checkError();
+		impl->pendingProgram = 0;
+		impl->pendingVertexArray = 0;
+		impl->dirty = true;
 
 		impl->pipeline = nullptr;
 	}
@@ -510,19 +955,23 @@ namespace sge
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
     }
 
-	void bindBuffer(Buffer* buffer)
+	void GraphicsDevice::bindVertexBuffer(Buffer* buffer)
 	{
+		SGE_ASSERT(impl->pipeline);
+
 		GL4Buffer* gl4Buffer = reinterpret_cast<GL4Buffer*>(buffer);
-		glBindBuffer(gl4Buffer->target, gl4Buffer->id);
 
-		checkError();
-	}
+		// The attributes are stored in the vertex array, so they only change with the array or the buffer.
+		impl->flush();
+		impl->applyBuffer(GL_ARRAY_BUFFER, gl4Buffer->id);
 
-	void GraphicsDevice::bindVertexBuffer(Buffer* buffer)
-	{
-		SGE_ASSERT(impl->pipeline);
+		if (!impl->countChange(impl->attribVertexArray != impl->vertexArray || impl->attribBuffer != gl4Buffer->id))
+		{
+			return;
+		}
 
-		bindBuffer(buffer);
+		impl->attribVertexArray = impl->vertexArray;
+		impl->attribBuffer = gl4Buffer->id;
 
 		for (size_t i = 0; i < impl->pipeline->vertexLayout.count; i++)
 		{
@@ -540,18 +989,24 @@ namespace sge
 		checkError();
 	}
 
-	void GraphicsDevice::bindIndexBuffer(Buffer* buffer)
+	void GraphicsDevice::bindIndexBuffer(Buffer* buffer, IndexFormat format)
 	{
 		SGE_ASSERT(impl->pipeline);
 
-		bindBuffer(buffer);
+		impl->flush();
+		impl->applyBuffer(GL_ELEMENT_ARRAY_BUFFER, reinterpret_cast<GL4Buffer*>(buffer)->id);
+
+		// The index type is given to each draw, it isn't bound state.
+		impl->indexType = format == IndexFormat::UINT16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+		checkError();
 	}
 
 	void GraphicsDevice::bindVertexUniformBuffer(Buffer* buffer, size_t slot)
 	{
 		SGE_ASSERT(impl->pipeline);
 
-		glBindBufferBase(GL_UNIFORM_BUFFER, slot, reinterpret_cast<GL4Buffer*>(buffer)->id);
+		impl->applyUniformBuffer(slot, reinterpret_cast<GL4Buffer*>(buffer)->id);
 
 		checkError();
 	}
@@ -560,53 +1015,64 @@ namespace sge
 	{
 		SGE_ASSERT(impl->pipeline);
 
-		glBindBufferBase(GL_UNIFORM_BUFFER, slot, reinterpret_cast<GL4Buffer*>(buffer)->id);
+		impl->applyUniformBuffer(slot, reinterpret_cast<GL4Buffer*>(buffer)->id);
 
 		checkError();
 	}
 
-	void GraphicsDevice::bindViewport(Viewport* viewport)
+	void GraphicsDevice::bindVertexUniformBuffer(Buffer* buffer, size_t slot, size_t offset, size_t size)
 	{
-		glViewport(viewport->x, viewport->y, viewport->width, viewport->height);
+		SGE_ASSERT(impl->pipeline);
+
+		impl->applyUniformBufferRange(slot, reinterpret_cast<GL4Buffer*>(buffer)->id, offset, size);
 
 		checkError();
 	}
 
-	void GraphicsDevice::bindTexture(Texture* texture, size_t slot)
+	void GraphicsDevice::bindPixelUniformBuffer(Buffer* buffer, size_t slot, size_t offset, size_t size)
 	{
-		glActiveTexture(GL_TEXTURE0 + slot);
-		glBindTexture(GL_TEXTURE_2D, reinterpret_cast<GL4Texture*>(texture)->id);
+		SGE_ASSERT(impl->pipeline);
+
+		impl->applyUniformBufferRange(slot, reinterpret_cast<GL4Buffer*>(buffer)->id, offset, size);
 
 		checkError();
 	}
 
-	void GraphicsDevice::debindTexture(Texture* texture, size_t slot)
+	void GraphicsDevice::bindViewport(const Viewport* viewport)
 	{
-        glActiveTexture(GL_TEXTURE0 + slot);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		impl->applyViewport(*viewport);
 
 		checkError();
 	}
 
-	void GraphicsDevice::bindCubeMap(CubeMap* cubeMap, size_t slot)
+	void GraphicsDevice::bindTexture(Texture* texture, size_t slot)
 	{
-		glActiveTexture(GL_TEXTURE0 + slot);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, reinterpret_cast<GL4CubeMap*>(cubeMap)->id);
+		impl->touchTextureSlot(slot, GL_TEXTURE_2D);
+		impl->pendingTextures[slot] = reinterpret_cast<GL4Texture*>(texture)->id;
+	}
 
-		checkError();
+	void GraphicsDevice::debindTexture(Texture* texture, size_t slot)
+	{
+		impl->touchTextureSlot(slot, GL_TEXTURE_2D);
+		impl->pendingTextures[slot] = 0;
 	}
 
-	void GraphicsDevice::debindCubeMap(CubeMap* cubeMap, size_t slot)
+	void GraphicsDevice::bindCubeMap(CubeMap* cubeMap, size_t slot)
 	{
-		glActiveTexture(GL_TEXTURE0 + slot);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		impl->touchTextureSlot(slot, GL_TEXTURE_CUBE_MAP);
+		impl->pendingCubeMaps[slot] = reinterpret_cast<GL4CubeMap*>(cubeMap)->id;
+	}
 
-		checkError();
+	void GraphicsDevice::debindCubeMap(CubeMap* cubeMap, size_t slot)
+	{
+		impl->touchTextureSlot(slot, GL_TEXTURE_CUBE_MAP);
+		impl->pendingCubeMaps[slot] = 0;
 	}
 
 	void GraphicsDevice::copyData(Buffer* buffer, size_t size, const void* data)
 	{
 		GL4Buffer* gl4Buffer = reinterpret_cast<GL4Buffer*>(buffer);
+		impl->applyBuffer(gl4Buffer->target, gl4Buffer->id);
 		glBufferData(gl4Buffer->target, size, data, gl4Buffer->usage);
 		gl4Buffer->header.size = size;
 		checkError();
@@ -615,6 +1081,7 @@ namespace sge
 	void GraphicsDevice::copySubData(Buffer* buffer, size_t offset, size_t size, const void* data)
 	{
 		GL4Buffer* gl4Buffer = reinterpret_cast<GL4Buffer*>(buffer);
+		impl->applyBuffer(gl4Buffer->target, gl4Buffer->id);
 		glBufferSubData(gl4Buffer->target, offset, size, data);
 
 		checkError();
@@ -622,6 +1089,8 @@ namespace sge
 
 	void GraphicsDevice::draw(size_t count)
 	{
+		impl->flush();
+
 		glDrawArrays(GL_TRIANGLES, 0, count);
 
 		checkError();
@@ -629,13 +1098,17 @@ namespace sge
 
 	void GraphicsDevice::drawIndexed(size_t count)
 	{
-		glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+		impl->flush();
+
+		glDrawElements(GL_TRIANGLES, count, impl->indexType, nullptr);
 
 		checkError();
 	}
 
 	void GraphicsDevice::drawInstanced(size_t count, size_t instanceCount)
 	{
+		impl->flush();
+
 		glDrawArraysInstanced(GL_TRIANGLES, 0, count, instanceCount);
 
 		checkError();
@@ -643,7 +1116,9 @@ namespace sge
 
 	void GraphicsDevice::drawInstancedIndexed(size_t count, size_t instanceCount)
 	{
-		glDrawElementsInstanced(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr, instanceCount);
+		impl->flush();
+
+		glDrawElementsInstanced(GL_TRIANGLES, count, impl->indexType, nullptr, instanceCount);
 
 		checkError();
 	}
@@ -0,0 +1,21 @@
+#include "Renderer/NullGraphicsDevice.h"
+
+namespace sge
+{
+	NullGraphicsDevice::NullGraphicsDevice()
+	{
+		counters.issued = 0;
+		counters.skipped = 0;
+	}
+
+	NullGraphicsDevice::~NullGraphicsDevice()
+	{
+	}
+
+	void* NullGraphicsDevice::allocateStreamData(Buffer*, size_t, size_t& offset)
+	{
+		offset = 0;
+
+		return nullptr;
+	}
+}
@@ -0,0 +1,105 @@
+#include "Renderer/RenderCommand.h"
+#include "Core/Assert.h"
+
+namespace sge
+{
+	namespace
+	{
+		inline uint64 getMask(uint32 bits)
+		{
+			return bits >= 64 ? ~0ull : (1ull << bits) - 1;
+		}
+
+		/** \brief Writes the value to the bits right below the already written ones. */
+		inline void pack(uint64& key, uint32& shift, uint64 value, uint32 bits)
+		{
+			shift -= bits;
+
+			if (bits > 0)
+			{
+				key |= (value & getMask(bits)) << shift;
+			}
+		}
+	}
+
+	SortKeyEncoder::SortKeyEncoder(const SortKeyLayout& layout, float maxDepth)
+	{
+		setLayout(layout);
+		setMaxDepth(maxDepth);
+	}
+
+	void SortKeyEncoder::setLayout(const SortKeyLayout& layout)
+	{
+		SGE_ASSERT(layout.depthBits <= 32);
+		SGE_ASSERT((1ull << layout.layerBits) >= MAX_RENDER_LAYERS);
+		SGE_ASSERT(layout.viewBits + layout.layerBits + 1 + layout.pipelineBits +
+			layout.materialBits + layout.textureBits + layout.depthBits == 64);
+
+		this->layout = layout;
+	}
+
+	void SortKeyEncoder::setMaxDepth(float maxDepth)
+	{
+		SGE_ASSERT(maxDepth > 0.0f);
+
+		this->maxDepth = maxDepth;
+	}
+
+	RenderCommand SortKeyEncoder::encode(const SortKeyFields& fields) const
+	{
+		const uint64 depthMax = getMask(layout.depthBits);
+
+		float normalized = fields.depth / maxDepth;
+		normalized = normalized < 0.0f ? 0.0f : (normalized > 1.0f ? 1.0f : normalized);
+
+		uint64 depth = static_cast<uint64>(normalized * static_cast<float>(depthMax));
+		depth = depth > depthMax ? depthMax : depth;
+
+		uint64 key = 0;
+		uint32 shift = 64;
+
+		pack(key, shift, fields.view, layout.viewBits);
+		pack(key, shift, fields.layer, layout.layerBits);
+		pack(key, shift, fields.translucent ? 1 : 0, 1);
+
+		if (fields.translucent)
+		{
+			pack(key, shift, depthMax - depth, layout.depthBits);
+		}
+
+		pack(key, shift, fields.pipeline, layout.pipelineBits);
+		pack(key, shift, fields.material, layout.materialBits);
+		pack(key, shift, fields.texture, layout.textureBits);
+
+		if (!fields.translucent)
+		{
+			pack(key, shift, depth, layout.depthBits);
+		}
+
+		RenderCommand command;
+		command.bits = key;
+
+		return command;
+	}
+
+	uint32 SortKeyEncoder::decodeView(const RenderCommand command) const
+	{
+		uint32 shift = 64 - layout.viewBits;
+
+		return layout.viewBits == 0 ? 0 : static_cast<uint32>(command.bits >> shift);
+	}
+
+	uint32 SortKeyEncoder::decodeLayer(const RenderCommand command) const
+	{
+		uint32 shift = 64 - layout.viewBits - layout.layerBits;
+
+		return static_cast<uint32>((command.bits >> shift) & getMask(layout.layerBits));
+	}
+
+	bool SortKeyEncoder::decodeTranslucent(const RenderCommand command) const
+	{
+		uint32 shift = 63 - layout.viewBits - layout.layerBits;
+
+		return ((command.bits >> shift) & 1) != 0;
+	}
+}
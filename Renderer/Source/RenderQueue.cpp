@@ -3,14 +3,55 @@
 #include "Renderer/RenderQueue.h"
 #include "Renderer/RenderCommand.h"
 #include "Renderer/GraphicsDevice.h"
+#include "Core/ThreadPool.h"
 
 namespace sge
 {
-	RenderQueue::RenderQueue(size_t size) :
+	namespace
+	{
+		const size_t PASS_COUNT = sizeof(uint64);
+		const size_t BUCKET_COUNT = 256;
+
+		// Smaller queues sort faster on one thread than it takes to wake the workers.
+		const size_t PARALLEL_THRESHOLD = 8192;
+
+		inline size_t getByte(uint64 key, size_t pass)
+		{
+			return static_cast<size_t>(key >> (pass * 8)) & (BUCKET_COUNT - 1);
+		}
+	}
+
+	RenderQueue::Segment::Segment(size_t size, uint16 index, const bool* acceptingCommands) :
+		acceptingCommands(acceptingCommands),
+		index(index)
+	{
+		items.reserve(size);
+		arena.reserve(size * sizeof(DrawMeshPacket));
+	}
+
+	RenderQueue::RenderQueue(size_t size, size_t segmentCount) :
+		pool(nullptr),
+		size(size),
 		acceptingCommands(false)
 	{
-		// TODO use page pool allocator.
-		queue.reserve(size);
+		items.reserve(size);
+		setSegmentCount(segmentCount);
+	}
+
+	void RenderQueue::setSegmentCount(size_t count)
+	{
+		SGE_ASSERT(!acceptingCommands && count > 0 && count <= UINT16_MAX);
+
+		while (segments.size() > count)
+		{
+			segments.pop_back();
+		}
+
+		while (segments.size() < count)
+		{
+			uint16 index = static_cast<uint16>(segments.size());
+			segments.emplace_back(new Segment(size, index, &acceptingCommands));
+		}
 	}
 
 	void RenderQueue::begin()
@@ -21,20 +62,155 @@ namespace sge
 	void RenderQueue::end()
 	{
 		acceptingCommands = false;
+
+		// Segment order, then submission order within a segment. The sort keeps it for equal keys.
+		items.clear();
+
+		for (auto& segment : segments)
+		{
+			items.insert(items.end(), segment->items.begin(), segment->items.end());
+		}
+
 		sort();
 	}
 
 	void RenderQueue::sort()
 	{
-		std::sort(std::begin(queue), std::end(queue), 
-			[](const std::pair<RenderCommand, RenderFunction>& lhs, const std::pair<RenderCommand, RenderFunction>& rhs)
-		{
-			return lhs.first.bits < rhs.first.bits;
-		});
+		radixSort();
 	}
 
 	void RenderQueue::clear()
 	{
-		queue.clear();
+		items.clear();
+
+		for (auto& segment : segments)
+		{
+			segment->items.clear();
+			segment->arena.clear();
+		}
+	}
+
+	void RenderQueue::radixSort()
+	{
+		const size_t count = items.size();
+
+		if (count < 2)
+		{
+			return;
+		}
+
+		scratch.resize(count);
+
+		// Each chunk is counted and scattered by one task. Chunks are contiguous and scattered
+		// to consecutive ranges of every bucket, which keeps the sort stable.
+		const size_t chunkCount = pool && count >= PARALLEL_THRESHOLD ? pool->getWorkerCount() + 1 : 1;
+		histograms.assign(chunkCount * PASS_COUNT * BUCKET_COUNT, 0);
+
+		auto forEachChunk = [&](const ThreadPool::Task& task)
+		{
+			if (chunkCount == 1)
+			{
+				task(0);
+			}
+			else
+			{
+				pool->dispatch(chunkCount, task);
+			}
+		};
+
+		auto getCounts = [&](size_t chunk, size_t pass)
+		{
+			return &histograms[(chunk * PASS_COUNT + pass) * BUCKET_COUNT];
+		};
+
+		Item* source = items.data();
+		Item* target = scratch.data();
+
+		// Counts every byte of every key in one read, the totals tell which passes can be skipped.
+		forEachChunk([&](size_t chunk)
+		{
+			size_t begin = count * chunk / chunkCount;
+			size_t end = count * (chunk + 1) / chunkCount;
+
+			for (size_t i = begin; i < end; i++)
+			{
+				for (size_t pass = 0; pass < PASS_COUNT; pass++)
+				{
+					getCounts(chunk, pass)[getByte(source[i].key, pass)]++;
+				}
+			}
+		});
+
+		bool counted = true;
+
+		for (size_t pass = 0; pass < PASS_COUNT; pass++)
+		{
+			size_t bucket = getByte(source[0].key, pass);
+			size_t total = 0;
+
+			for (size_t chunk = 0; chunk < chunkCount; chunk++)
+			{
+				total += getCounts(chunk, pass)[bucket];
+			}
+
+			// Every key has the same byte, the pass wouldn't move anything.
+			if (total == count)
+			{
+				continue;
+			}
+
+			// A scatter moves items between chunks, so the per chunk counts of later passes have to be redone.
+			if (!counted)
+			{
+				forEachChunk([&](size_t chunk)
+				{
+					size_t begin = count * chunk / chunkCount;
+					size_t end = count * (chunk + 1) / chunkCount;
+					size_t* counts = getCounts(chunk, pass);
+
+					std::fill(counts, counts + BUCKET_COUNT, 0);
+
+					for (size_t i = begin; i < end; i++)
+					{
+						counts[getByte(source[i].key, pass)]++;
+					}
+				});
+			}
+
+			// Turns the counts into the first target index of each (bucket, chunk).
+			size_t offset = 0;
+
+			for (size_t b = 0; b < BUCKET_COUNT; b++)
+			{
+				for (size_t chunk = 0; chunk < chunkCount; chunk++)
+				{
+					size_t* counts = getCounts(chunk, pass);
+					size_t bucketCount = counts[b];
+
+					counts[b] = offset;
+					offset += bucketCount;
+				}
+			}
+
+			forEachChunk([&](size_t chunk)
+			{
+				size_t begin = count * chunk / chunkCount;
+				size_t end = count * (chunk + 1) / chunkCount;
+				size_t* offsets = getCounts(chunk, pass);
+
+				for (size_t i = begin; i < end; i++)
+				{
+					target[offsets[getByte(source[i].key, pass)]++] = source[i];
+				}
+			});
+
+			std::swap(source, target);
+			counted = chunkCount == 1;
+		}
+
+		if (source != items.data())
+		{
+			items.swap(scratch);
+		}
 	}
-}
\ No newline at end of file
+}
@@ -5,10 +5,17 @@
 
 namespace sge
 {
-	Window::Window(const char* title, int x, int y, int width, int height) :
+	Window::Window(const char* title, int x, int y, int width, int height, bool headless) :
+		window(nullptr),
 		width(width),
-		height(height)
+		height(height),
+		headless(headless)
 	{
+		if (headless)
+		{
+			return;
+		}
+
 		Uint32 flags = SDL_WINDOW_SHOWN;
 
 #if defined(OPENGL4)
@@ -19,7 +26,10 @@ namespace sge
 
 	Window::~Window()
 	{
-		SDL_DestroyWindow(window);
+		if (window)
+		{
+			SDL_DestroyWindow(window);
+		}
 	}
 
 	SDL_Window* Window::getSDLWindow()
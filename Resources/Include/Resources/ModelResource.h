@@ -17,7 +17,9 @@
 #include "stb_image.h"
 
 #include "Resources/TextureResource.h"
+#include "Core/Bounds.h"
 #include "Core/Math.h"
+#include "Core/Types.h"
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "Renderer/Texture.h"
@@ -51,6 +53,10 @@ namespace sge
 
 		sge::Buffer* vertexBuffer;
 		sge::Buffer* indexBuffer;
+		sge::IndexFormat indexFormat;
+
+		sge::AABB bounds;			/**< Bounds of the vertices in model space. */
+		sge::BoundingSphere sphere;
 
 		/*  Functions  */
 		// Constructor
@@ -62,6 +68,16 @@ namespace sge
 			diffuseTexture = nullptr;
 			normalTexture = nullptr;
 			specularTexture = nullptr;
+			indexFormat = sge::IndexFormat::UINT32;
+
+			bounds = sge::AABB::empty();
+
+			for (auto& vertex : this->vertices)
+			{
+				bounds.grow(vertex.Position);
+			}
+
+			sphere = sge::BoundingSphere::fromAABB(bounds);
 		}
 
 		void createBuffers(GraphicsDevice* device)
@@ -81,12 +97,25 @@ namespace sge
                     specularTexture = device->createTexture(&texture);
 				}
 			}
-			//plaa
+
 			vertexBuffer = device->createBuffer(sge::BufferType::VERTEX, sge::BufferUsage::DYNAMIC, vertices.size()*sizeof(Vertex));
-			indexBuffer = device->createBuffer(sge::BufferType::INDEX, sge::BufferUsage::DYNAMIC, indices.size()*sizeof(unsigned int));
-			device->bindVertexBuffer(vertexBuffer);
-			device->bindIndexBuffer(indexBuffer);
 			device->copyData(vertexBuffer, sizeof(Vertex) * vertices.size(), vertices.data());
+
+			// Half the index memory and bandwidth when every vertex can be addressed with 16 bits.
+			if (vertices.size() < 65536)
+			{
+				std::vector<uint16> shortIndices(indices.begin(), indices.end());
+
+				indexFormat = sge::IndexFormat::UINT16;
+				indexBuffer = device->createBuffer(sge::BufferType::INDEX, sge::BufferUsage::DYNAMIC, shortIndices.size()*sizeof(uint16));
+				device->copyData(indexBuffer, sizeof(uint16) * shortIndices.size(), shortIndices.data());
+			}
+			else
+			{
+				indexFormat = sge::IndexFormat::UINT32;
+				indexBuffer = device->createBuffer(sge::BufferType::INDEX, sge::BufferUsage::DYNAMIC, indices.size()*sizeof(unsigned int));
+				device->copyData(indexBuffer, sizeof(unsigned int) * indices.size(), indices.data());
+			}
 		}
 
 		sge::Buffer* getVertexBuffer()
@@ -99,6 +128,12 @@ namespace sge
 			return indexBuffer;
 		}
 
+		/** \brief Type of the indices in the index buffer, set by createBuffers. */
+		sge::IndexFormat getIndexFormat()
+		{
+			return indexFormat;
+		}
+
 		void setDiffuseTexture(sge::Texture* texture)
 		{
 			diffuseTexture = texture;
@@ -122,7 +157,11 @@ namespace sge
 		ModelResource(const std::string& resourcePath);
 		~ModelResource();
 
-		std::vector<Mesh*> getMeshes();
+		const std::vector<Mesh*>& getMeshes();
+
+		/** \brief Bounds of all meshes in model space, computed at load. */
+		const AABB& getBounds() const { return bounds; }
+		const BoundingSphere& getBoundingSphere() const { return sphere; }
 
 		void createBuffers();
 
@@ -132,6 +171,8 @@ namespace sge
         GraphicsDevice* device;
 		/*  Model Data  */
 		std::vector<Mesh*> meshes;
+		AABB bounds;
+		BoundingSphere sphere;
 		std::string directory;
 		std::vector<sge::TextureResource> textures_loaded; // Stores all the textures loaded so far, optimization to make sure textures aren't loaded more than once.
 
@@ -1,5 +1,7 @@
 #pragma once
 #include <vector>
+#include <condition_variable>
+#include <mutex>
 #include <unordered_map>
 #include "Core/Assert.h"
 #include "Resources/Resource.h"
@@ -23,6 +25,10 @@
 // and make sure they are not unloaded before all the references are cleared.
 //
 // When handle is no longer needed, release it to keep track of references.
+//
+// Resources can be loaded from several threads at once, e.g. by a scene loading
+// in the background. Different files are read in parallel, the bookkeeping is locked.
+// A file is only loaded once, threads asking for a file that is being loaded wait for it.
 
 namespace sge
 {
@@ -46,17 +52,38 @@ namespace sge
 				return Handle<T>();		// Returns a null handle which can be used for error checking.
 			}
 
+			std::unique_lock<std::mutex> lock(mutex);
+
+			// A null resource is a file another thread is loading.
+			std::unordered_map<std::string, sge::Resource*>::iterator it = userData.find(filename);
+
+			while (it != userData.end() && it->second == nullptr)
+			{
+				loaded.wait(lock);
+				it = userData.find(filename);
+			}
+
+			if (it == userData.end())
+			{
+				// Claim the file, then read it without holding the lock.
+				userData.insert({ filename, nullptr });
+
+				lock.unlock();
+				T* resource = new T(filename);
+				lock.lock();
+
+				it = userData.find(filename);
+				it->second = resource;
+				loaded.notify_all();
+			}
+
 			Handle<T> handle(this);
 			unsigned int index;
 
-			// Create a new resource pointer of our template type.
-			T* resource = new T(filename);
-
 			if (freeSlots.empty())
 			{
 				index = magicNumbers.size();
 				handle.init(index);
-				userData.insert({ filename, resource });
 				magicNumbers.push_back(handle.getMagic());
 			}
 			else
@@ -67,18 +94,21 @@ namespace sge
 				magicNumbers[index] = handle.getMagic();
 			}
 
+			// A reused slot takes the path of the new resource.
+			if (index == pathVec.size())
+			{
+				pathVec.push_back(filename);
+			}
+			else
+			{
+				pathVec[index] = filename;
+			}
+
 			// Assertion to make sure our resource "chain" doesn't break
-			pathVec.push_back(filename);
 			SGE_ASSERT(pathVec.at(index) == filename);
 
 			// Finally we add +1 to our resource references.
-			std::unordered_map<std::string, sge::Resource*>::iterator it;
-			it = userData.find(filename);
-
-			if (it != userData.end())
-			{
-				(*it).second->increaseRef();
-			}
+			(*it).second->increaseRef();
 
 			return handle;
 		};
@@ -87,6 +117,8 @@ namespace sge
 		template <class T>
 		void release(Handle<T> handle)
 		{
+			std::lock_guard<std::mutex> lock(mutex);
+
 			unsigned int index = handle.getIndex();
 
 			SGE_ASSERT(index < pathVec.size());
@@ -104,18 +136,22 @@ namespace sge
 				(*it).second->decreaseRef();
 			}
 
+			std::cout << filename << " | Handle released. References: " << (*it).second->getReferenceCount() << std::endl;
+
 			if ((*it).second->getReferenceCount() == 0) // If references have reached 0, we'll remove resource from memory.
 			{
-				(*it).second->~Resource();
+				// Erased so the next load reads the file again instead of reusing the freed resource.
+				delete (*it).second;
+				userData.erase(it);
 			}
-
-			std::cout << filename << " | Handle released. References: " << (*it).second->getReferenceCount() << std::endl;
 		};
 
 		// Function to retrieve a resource pointer from our handle.
 		template <typename T>
 		T* getResource(sge::Handle<T>& handle)
 		{
+			std::lock_guard<std::mutex> lock(mutex);
+
 			std::string path = pathVec.at(handle.getIndex());
 
 			std::unordered_map<std::string, sge::Resource*>::iterator it;
@@ -148,6 +184,12 @@ namespace sge
 		// Resource paths.
 		std::vector<std::string> pathVec;
 
+		// Guards the containers above and the handle magic numbers.
+		std::mutex mutex;
+
+		// Signaled when a file has finished loading.
+		std::condition_variable loaded;
+
 		// Deletes all loaded resources.
 		void releaseAll();
 
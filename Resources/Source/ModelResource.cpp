@@ -6,13 +6,22 @@ namespace sge
 	ModelResource::ModelResource(const std::string& resourcePath) : sge::Resource(resourcePath)
 	{
 		this->loadModel(resourcePath);
+
+		bounds = AABB::empty();
+
+		for (auto mesh : meshes)
+		{
+			bounds.grow(mesh->bounds);
+		}
+
+		sphere = BoundingSphere::fromAABB(bounds);
 	}
 	ModelResource::~ModelResource()
 	{
 		meshes.erase(meshes.begin(), meshes.end());
 	}
 
-	std::vector<Mesh*> ModelResource::getMeshes()
+	const std::vector<Mesh*>& ModelResource::getMeshes()
 	{
 		return meshes;
 	}
@@ -31,7 +40,10 @@ namespace sge
 	{
 		// Read file via ASSIMP
 		Assimp::Importer importer;
-		const aiScene* scene = importer.ReadFile(path, aiProcess_GenNormals || aiProcess_CalcTangentSpace);
+		// Identical vertices are welded and the triangles reordered, so the indexed draws reuse
+		// vertices from the post-transform cache.
+		const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_CalcTangentSpace |
+			aiProcess_JoinIdenticalVertices | aiProcess_ImproveCacheLocality);
 		// Check for errors
 		if (!scene || scene->mFlags == AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) // if is Not Zero
 		{
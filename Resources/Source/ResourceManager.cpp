@@ -12,8 +12,16 @@ namespace sge
 
 	void ResourceManager::printResources()
 	{
+		std::lock_guard<std::mutex> lock(mutex);
+
 		for (auto resource : userData)
 		{
+			// Still loading on another thread.
+			if (resource.second == nullptr)
+			{
+				continue;
+			}
+
 			std::cout << resource.first << ": "
 				<< resource.second->getReferenceCount() << " references" << std::endl;
 		}
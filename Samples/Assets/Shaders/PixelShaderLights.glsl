@@ -40,20 +40,28 @@ struct PointLight
 	
 };
 
-layout(binding = 1, std140) uniform pixelUniform
+layout(binding = 1, std140) uniform frameUniform
 {
 	DirLight dirLight[NUM_DIR_LIGHTS];
 	PointLight pointLights[NUM_POINT_LIGHTS];
-	vec4 viewPos;
 	float numofpl;
 	float numofdl;
 	float numofsl;
+	float pad;
+};
+
+layout(binding = 2, std140) uniform cameraUniform
+{
+	vec4 viewPos;
+};
+
+layout(binding = 3, std140) uniform materialUniform
+{
 	float glossyness;
 	int hasDiffuseTex;
 	int hasNormalTex;
 	int hasSpecularTex;
 	int hasCubeTex;
-	float pad;
 };
 
 vec3 CalculateDirectionLight(DirLight light, vec3 normal, vec3 viewDir);
@@ -0,0 +1,13 @@
+#version 440 core
+
+in vec2 outTexCoords;
+in vec4 outColor;
+
+layout(location = 0) out vec4 finalColor;
+
+layout(binding = 0) uniform sampler2D texture;
+
+void main()
+{
+	finalColor = texture2D(texture, outTexCoords) * outColor;
+}
@@ -1,72 +1,355 @@
 #include "Game/EntityManager.h"
+#include "Game/SceneSnapshot.h"
 #include "Game/TransformComponent.h"
-#include "Game/InputComponent.h"
-#include "Game/TestComponent.h"
-#include "Game/SystemManager.h"
+#include "Game/TransformSystem.h"
 #include "Game/ComponentFactory.h"
-#include "SDL2/SDL.h"
 #include "Core/Math.h"
-#include "Renderer/Window.h"
-#include "Game/RenderSystem.h"
-#include "Renderer/GraphicsDevice.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
 
-int main(int argc, char** argv)
+// Headless ECS benchmark. Prints the results as JSON to stdout.
+//
+// Usage: ECSample [--repeat n] [entity count...]
+//
+// Every case is run the given number of times and the median is reported, so the numbers
+// of different storage strategies can be compared. Keys and case order never change, new
+// cases are added at the end.
+
+namespace
 {
-	SDL_Init(SDL_INIT_VIDEO); // Initializing
+	class VelocityComponent : public sge::Component
+	{
+	public:
+		VelocityComponent(sge::Entity* ent) : Component(ent), velocity(1.0f, 0.0f, 0.0f)
+		{
+		}
 
-	SDL_Event event;
+		void update()
+		{
+		}
 
-	sge::Window window("The test to end all tests.", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 800, 600);
-    sge::RenderSystem renderer(window);
-	renderer.init();
+		sge::math::vec3 velocity;
+	};
 
-	sge::ComponentFactory<sge::TransformComponent> transFactor;
+	using Clock = std::chrono::high_resolution_clock;
 
-	// Create EntityManager
-	
-	sge::EntityManager EManager;
-	// Create an entity through the manager
+	const size_t HIERARCHY_DEPTH = 4; // Transforms per parent chain in the propagation case.
 
-	
+	const char* const SNAPSHOT_PATH = "ECSample.sges"; // Written and read back by the snapshot cases.
 
-	sge::Entity* player1 = EManager.createEntity();
-	sge::Entity* player2 = EManager.createEntity();
+	const char* const CASES[] =
+	{
+		"create_entities",
+		"add_components",
+		"iterate_single",
+		"iterate_multi",
+		"get_component",
+		"transform_propagation",
+		"remove_components",
+		"destroy_entities",
+		"save_scene",
+		"load_scene"
+	};
 
+	enum Case
+	{
+		CREATE_ENTITIES,
+		ADD_COMPONENTS,
+		ITERATE_SINGLE,
+		ITERATE_MULTI,
+		GET_COMPONENT,
+		TRANSFORM_PROPAGATION,
+		REMOVE_COMPONENTS,
+		DESTROY_ENTITIES,
+		SAVE_SCENE,
+		LOAD_SCENE,
+		CASE_COUNT
+	};
 
-	// Give Entities components by asking the factory of that specific component type.
-	player1->setComponent(transFactor.create(player1));
-	player1->setComponent(transFactor.create(player1));
+	struct Sample
+	{
+		double seconds;
+		size_t operations;
+	};
+
+	// Keeps the optimizer from dropping the iteration results.
+	volatile float sink;
+
+	class Timer
+	{
+	public:
+		Timer() : start(Clock::now())
+		{
+		}
 
+		double seconds() const
+		{
+			return std::chrono::duration<double>(Clock::now() - start).count();
+		}
 
-	// Give the entity a certain component
-	// Looooop
+	private:
+		Clock::time_point start;
+	};
 
-	bool running = true;
-	while (running)
+	// Saves the transforms and their hierarchy, loads them into a new scene and checks that
+	// every loaded transform ended up where the saved one was.
+	bool runSnapshot(sge::EntityManager& entityManager, sge::ComponentFactory<sge::TransformComponent>& transformFactory, Sample* samples)
 	{
-		renderer.getDevice()->clear(0.5f, 0.0f, 0.7f, 1.0f);
+		size_t count = entityManager.getEntities().size();
+
+		{
+			sge::SceneSnapshot snapshot;
+			snapshot.bind(transformFactory);
+
+			Timer timer;
+			bool saved = snapshot.save(SNAPSHOT_PATH, entityManager);
+			samples[SAVE_SCENE] = { timer.seconds(), count };
+
+			if (!saved)
+			{
+				return false;
+			}
+		}
+
+		sge::EntityManager loadedManager;
+		sge::ComponentFactory<sge::TransformComponent> loadedFactory;
+		sge::SceneSnapshot snapshot;
+		snapshot.bind(loadedFactory);
+
+		Timer timer;
+		bool loaded = snapshot.load(SNAPSHOT_PATH, loadedManager);
+		samples[LOAD_SCENE] = { timer.seconds(), count };
+
+		std::remove(SNAPSHOT_PATH);
+
+		const std::vector<sge::Entity*>& entities = entityManager.getEntities();
+		const std::vector<sge::Entity*>& loadedEntities = snapshot.getLoadedEntities();
+
+		if (!loaded || loadedEntities.size() != count)
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			sge::TransformComponent* transform = entities[i]->getComponent<sge::TransformComponent>();
+			sge::TransformComponent* loadedTransform = loadedEntities[i]->getComponent<sge::TransformComponent>();
+
+			if (loadedTransform == nullptr || loadedTransform->getMatrix() != transform->getMatrix())
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// One full entity lifetime at the given count, every case timed once. False if the
+	// loaded scene doesn't match the saved one.
+	bool runOnce(size_t count, Sample* samples)
+	{
+		sge::EntityManager entityManager;
+		sge::ComponentFactory<sge::TransformComponent> transformFactory;
+		sge::ComponentFactory<VelocityComponent> velocityFactory;
+		sge::TransformSystem transformSystem;
+
+		std::vector<sge::Entity*> entities;
+		entities.reserve(count);
+
+		{
+			Timer timer;
+
+			for (size_t i = 0; i < count; i++)
+			{
+				entities.push_back(entityManager.createEntity());
+			}
+
+			samples[CREATE_ENTITIES] = { timer.seconds(), count };
+		}
+
+		{
+			Timer timer;
+
+			for (auto entity : entities)
+			{
+				transformSystem.addComponent(transformFactory.create(entity));
+				velocityFactory.create(entity);
+			}
+
+			samples[ADD_COMPONENTS] = { timer.seconds(), count * 2 };
+		}
+
+		{
+			Timer timer;
+			float sum = 0.0f;
+
+			for (auto transform : transformFactory.getComponents())
+			{
+				sum += transform->getPosition().x;
+			}
+
+			sink = sum;
+			samples[ITERATE_SINGLE] = { timer.seconds(), count };
+		}
+
+		{
+			Timer timer;
+
+			for (auto velocity : velocityFactory.getComponents())
+			{
+				sge::TransformComponent* transform = velocity->getComponent<sge::TransformComponent>();
+				transform->setPosition(transform->getPosition() + velocity->velocity);
+			}
+
+			samples[ITERATE_MULTI] = { timer.seconds(), count };
+		}
 
-		while (SDL_PollEvent(&event)) 
 		{
-			switch (event.type)
+			Timer timer;
+			size_t found = 0;
+
+			for (auto entity : entities)
 			{
-			case SDL_QUIT:
-				running = false;
-				break;
-			case SDL_KEYDOWN:
-				if (event.key.keysym.sym == SDLK_ESCAPE)
+				found += entity->getComponent<VelocityComponent>() != nullptr;
+			}
+
+			sink = static_cast<float>(found);
+			samples[GET_COMPONENT] = { timer.seconds(), count };
+		}
+
+		{
+			const std::vector<sge::TransformComponent*>& transforms = transformFactory.getComponents();
+
+			for (size_t i = 0; i < transforms.size(); i++)
+			{
+				if (i % HIERARCHY_DEPTH != 0)
 				{
-					running = false;
+					transforms[i]->setParentTransform(transforms[i - 1]);
 				}
 			}
+
+			// Sorts the hierarchy and clears the dirty flags so only propagation is timed.
+			transformSystem.update();
+
+			for (size_t i = 0; i < transforms.size(); i += HIERARCHY_DEPTH)
+			{
+				transforms[i]->setAngle(0.5f);
+			}
+
+			Timer timer;
+			transformSystem.update();
+			samples[TRANSFORM_PROPAGATION] = { timer.seconds(), count };
+		}
+
+		if (!runSnapshot(entityManager, transformFactory, samples))
+		{
+			return false;
+		}
+
+		{
+			Timer timer;
+
+			for (size_t i = entities.size(); i-- > 0;)
+			{
+				sge::TransformComponent* transform = entities[i]->getComponent<sge::TransformComponent>();
+
+				velocityFactory.remove(entities[i]->getComponent<VelocityComponent>());
+				transformSystem.removeComponent(transform);
+				transformFactory.remove(transform);
+			}
+
+			samples[REMOVE_COMPONENTS] = { timer.seconds(), count * 2 };
+		}
+
+		{
+			Timer timer;
+
+			for (size_t i = entities.size(); i-- > 0;)
+			{
+				entityManager.destroyEntity(entities[i]);
+			}
+
+			samples[DESTROY_ENTITIES] = { timer.seconds(), count };
 		}
 
-		renderer.getDevice()->swap();
+		return true;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	size_t repeat = 3;
+	std::vector<size_t> counts;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg(argv[i]);
+
+		if (arg == "--repeat" && i + 1 < argc)
+		{
+			repeat = std::max<size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+		}
+		else
+		{
+			counts.push_back(std::strtoul(argv[i], nullptr, 10));
+		}
+	}
+
+	if (counts.empty())
+	{
+		counts = { 10000, 100000, 1000000 };
+	}
+
+	std::printf("{\n  \"benchmark\": \"ecs\",\n  \"repeat\": %u,\n  \"results\": [\n", static_cast<unsigned>(repeat));
+
+	for (size_t c = 0; c < counts.size(); c++)
+	{
+		std::vector<std::vector<Sample>> runs(CASE_COUNT, std::vector<Sample>(repeat));
+		Sample samples[CASE_COUNT];
+
+		for (size_t r = 0; r < repeat; r++)
+		{
+			if (!runOnce(counts[c], samples))
+			{
+				std::fprintf(stderr, "Scene snapshot round trip failed at %u entities.\n", static_cast<unsigned>(counts[c]));
+				return 1;
+			}
+
+			for (size_t i = 0; i < CASE_COUNT; i++)
+			{
+				runs[i][r] = samples[i];
+			}
+		}
+
+		for (size_t i = 0; i < CASE_COUNT; i++)
+		{
+			std::vector<Sample>& run = runs[i];
+
+			std::sort(run.begin(), run.end(), [](const Sample& lhs, const Sample& rhs)
+			{
+				return lhs.seconds < rhs.seconds;
+			});
+
+			const Sample& median = run[run.size() / 2];
+			bool last = c + 1 == counts.size() && i + 1 == CASE_COUNT;
+
+			std::printf("    { \"case\": \"%s\", \"entities\": %u, \"operations\": %u, \"median_ms\": %.4f, \"min_ms\": %.4f, \"ns_per_op\": %.2f }%s\n",
+				CASES[i],
+				static_cast<unsigned>(counts[c]),
+				static_cast<unsigned>(median.operations),
+				median.seconds * 1000.0,
+				run.front().seconds * 1000.0,
+				median.seconds * 1e9 / median.operations,
+				last ? "" : ",");
+		}
 	}
 
-	// Testing component deletion
-	renderer.deinit();
+	std::printf("  ]\n}\n");
 
 	return 0;
-}
\ No newline at end of file
+}
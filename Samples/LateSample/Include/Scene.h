@@ -19,6 +19,8 @@
 #include "Resources/FontResource.h"
 #include "Game/TextComponent.h"
 
+#include <atomic>
+
 // FORWARD DECLARE
 struct sge::Pipeline;
 struct sge::Buffer;
@@ -35,6 +37,7 @@ public:
 	void update(float dt);
 	void draw();
 	void interpolate(float alpha);
+	bool snapshot(sge::FrameSnapshot& snapshot);
 
 	void setCubeMap(sge::ModelComponent *component, sge::math::ivec2 size, std::string top, std::string bottom, std::string left, std::string right, std::string front, std::string back);
 	void loadTextShader(const std::string& path, std::vector<char>& data);
@@ -92,6 +95,8 @@ private:
 	int mouseX, mouseY;
 	bool firstMouse = true;
 	bool useMouse = false;
+	std::atomic<bool> captureMouse;	/**< Set by update(), applied by draw() on the thread that owns the window. */
+	bool mouseCaptured = false;
 
 	// Text:
 	sge::Entity *textEntity;
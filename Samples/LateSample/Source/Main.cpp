@@ -5,6 +5,7 @@ int main(int argc, char** argv)
 {
 	sge::Spade spade;
 	spade.init();
+	spade.setPipelined(true);
 	spade.run(new Scene(&spade));
 	spade.quit();
 
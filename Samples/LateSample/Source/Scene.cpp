@@ -17,7 +17,7 @@
 
 #include"Audio/Audio.h"
 
-Scene::Scene(sge::Spade *engine) : engine(engine), renderer(engine->getRenderer()), fontResource(sge::ResourceManager::getMgr().load<sge::FontResource>("../Assets/verdana.ttf"))
+Scene::Scene(sge::Spade *engine) : engine(engine), renderer(engine->getRenderer()), captureMouse(false), fontResource(sge::ResourceManager::getMgr().load<sge::FontResource>("../Assets/verdana.ttf"))
 {
 	// Entity manager:
 	entityManager = new sge::EntityManager();
@@ -281,12 +281,12 @@ void Scene::update(float dt)
 	if (engine->keyboardInput->keyIsPressed(sge::KEYBOARD_1) && !useMouse)
 	{
 		useMouse = true;
-		SDL_SetRelativeMouseMode(SDL_TRUE);
+		captureMouse = true;
 	}
 	if (engine->keyboardInput->keyIsPressed(sge::KEYBOARD_2) && useMouse)
 	{
 		useMouse = false;
-		SDL_SetRelativeMouseMode(SDL_FALSE);
+		captureMouse = false;
 	}
 
 	if (engine->keyboardInput->keyIsPressed(sge::KEYBOARD_ESCAPE))
@@ -323,16 +323,29 @@ void Scene::update(float dt)
 	// ----------------------
 }
 
+bool Scene::snapshot(sge::FrameSnapshot& snapshot)
+{
+	snapshot.addCameras(1, &cameras.front());
+	snapshot.addModels(gameObjects.size(), gameObjects.data());
+	snapshot.addLights(pointLights.size(), pointLights.data());
+	snapshot.addLights(dirLights.size(), dirLights.data());
+	snapshot.addTexts(texts.size(), texts.data());
+
+	return true;
+}
+
 void Scene::draw()
 {
-	renderer->addCameras(1, &cameras.front());
+	// The next frame may be simulating, so only the snapshot is read here.
+	if (captureMouse != mouseCaptured)
+	{
+		mouseCaptured = captureMouse;
+		SDL_SetRelativeMouseMode(mouseCaptured ? SDL_TRUE : SDL_FALSE);
+	}
+
 	renderer->setClearColor(0.0, 0.3, 0.2, 1.0);
 	renderer->clear(sge::COLOR);
-	renderer->begin();
-	renderer->renderModels(gameObjects.size(), gameObjects.data());
-	renderer->renderLights(pointLights.size(), pointLights.data());
-	renderer->renderLights(dirLights.size(), dirLights.data());
-	renderer->renderTexts(texts.size(), texts.data());
+	renderer->begin(engine->getFrameSnapshot());
 	renderer->end();
 	renderer->render();
 	renderer->present();
@@ -5,6 +5,8 @@
 
 #include "Resources/ModelResource.h"
 #include "Resources/ResourceManager.h"
+#include "Resources/ShaderResource.h"
+#include "Resources/TextureResource.h"
 
 // Forward declares
 namespace sge
@@ -34,16 +36,20 @@ public:
     GameScene(sge::Spade* engine);
     ~GameScene();
 
+    void load(sge::ThreadPool& pool);
+    bool prepare();
+
     void update(float step);
     void interpolate(float alpha);
     void draw();
 
 private:
     void initPipelines();
-    void initResources();
+    void initBuffers(sge::Handle<sge::ModelResource>& resource, sge::Pipeline* pipeline);
+    void initEntities();
 
     sge::Entity* createEarth();
-    sge::Entity* createPerspectiveCamera(int x, int y, unsigned int width, unsigned int height);
+    sge::Entity* createPerspectiveCamera(int x, int y, unsigned int width, unsigned int height, sge::RenderTarget* target);
     sge::Entity* createOrthoCamera(int x, int y, unsigned int width, unsigned int height);
     sge::Entity* createSun();
     sge::Entity* createSkyBox();
@@ -74,6 +80,17 @@ private:
     sge::RenderSystem* renderer;
     sge::GraphicsDevice* device;
 
+    // Loaded by load(), the GPU objects are created from them by prepare() a step at a time.
+    size_t prepareStep;
+
+    sge::Handle<sge::ShaderResource> vertexShaderResource;
+    sge::Handle<sge::ShaderResource> pixelShaderResource;
+    sge::Handle<sge::ShaderResource> skyBoxVertexShaderResource;
+    sge::Handle<sge::ShaderResource> skyBoxPixelShaderResource;
+    sge::Handle<sge::ShaderResource> noLightsVertexShaderResource;
+    sge::Handle<sge::ShaderResource> noLightsPixelShaderResource;
+    sge::Handle<sge::TextureResource> skyBoxTextureResource;
+
     sge::Handle<sge::ModelResource> earthResource;
     sge::Handle<sge::ModelResource> sunResource;
     sge::Handle<sge::ModelResource> skyBoxResource;
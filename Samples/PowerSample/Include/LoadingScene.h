@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Game/Scene.h"
+
+namespace sge
+{
+    class Spade;
+}
+
+/** \brief Clears the screen while the GameScene loads in the background. */
+class LoadingScene : public sge::Scene
+{
+public:
+    LoadingScene(sge::Spade* engine);
+
+    void update(float step);
+    void interpolate(float alpha);
+    void draw();
+
+private:
+    sge::Spade* engine;
+};
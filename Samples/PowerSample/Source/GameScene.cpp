@@ -11,10 +11,19 @@
 #include "Renderer/RenderTarget.h"
 #include "Renderer/VertexLayout.h"
 
-#include "Resources/ShaderResource.h"
+#include "Core/ThreadPool.h"
 
 #include "Spade/Spade.h"
 
+#include <functional>
+
+namespace
+{
+    // The planet cameras draw the world, the fullscreen camera only the screens showing their targets.
+    const uint32 WORLD_LAYER = 0;
+    const uint32 SCREEN_LAYER = 1;
+}
+
 /*
 TODO enko
 
@@ -33,14 +42,82 @@ DX11 fixes go!
 GameScene::GameScene(sge::Spade* engine) :
     engine(engine),
     renderer(engine->getRenderer()),
-    device(renderer->getDevice())
+    device(renderer->getDevice()),
+    prepareStep(0)
 {
-    initPipelines();
-    initResources();
+}
 
-    overviewCamera = createPerspectiveCamera(0, 0, 620, 700);
-	spaceShipCamera = createPerspectiveCamera(0, 0, 620, 340);
-	earthCamera = createPerspectiveCamera(0, 0, 620, 340);
+void GameScene::load(sge::ThreadPool& pool)
+{
+#ifdef DIRECTX11
+    const std::string shaderExtension = ".cso";
+#elif OPENGL4
+    const std::string shaderExtension = ".glsl";
+#endif
+
+    sge::ResourceManager& resources = sge::ResourceManager::getMgr();
+
+    // Each file is read and decoded on its own worker.
+    std::function<void()> loads[] = {
+        [&] { vertexShaderResource = resources.load<sge::ShaderResource>("../Assets/Shaders/VertexShaderLights" + shaderExtension); },
+        [&] { pixelShaderResource = resources.load<sge::ShaderResource>("../Assets/Shaders/PixelShaderLights" + shaderExtension); },
+        [&] { skyBoxVertexShaderResource = resources.load<sge::ShaderResource>("../Assets/Shaders/VertexSkyBox" + shaderExtension); },
+        [&] { skyBoxPixelShaderResource = resources.load<sge::ShaderResource>("../Assets/Shaders/PixelSkyBox" + shaderExtension); },
+        [&] { noLightsVertexShaderResource = resources.load<sge::ShaderResource>("../Assets/Shaders/VertexShaderNoLights" + shaderExtension); },
+        [&] { noLightsPixelShaderResource = resources.load<sge::ShaderResource>("../Assets/Shaders/PixelShaderNoLights" + shaderExtension); },
+        [&] { skyBoxTextureResource = resources.load<sge::TextureResource>("../Assets/CubeMap/space.png"); },
+        [&] { earthResource = resources.load<sge::ModelResource>("../Assets/liteEarthDiffuseSpecular.dae"); },
+        [&] { spaceShipResource = resources.load<sge::ModelResource>("../Assets/SpaceShip.dae"); },
+        [&] { moonResource = resources.load<sge::ModelResource>("../Assets/moonSphere.dae"); },
+        [&] { sunResource = resources.load<sge::ModelResource>("../Assets/sunSphere.dae"); },
+        [&] { skyBoxResource = resources.load<sge::ModelResource>("../Assets/SkyBox.dae"); }
+    };
+
+    pool.dispatch(sizeof(loads) / sizeof(loads[0]), [&](size_t i)
+    {
+        loads[i]();
+    });
+}
+
+bool GameScene::prepare()
+{
+    // One step a frame, so the loading scene keeps drawing while the GPU objects are created.
+    switch (prepareStep++)
+    {
+    case 0:
+        initPipelines();
+        return false;
+    case 1:
+        initBuffers(earthResource, pipeline);
+        return false;
+    case 2:
+        initBuffers(spaceShipResource, pipeline);
+        return false;
+    case 3:
+        initBuffers(moonResource, pipeline);
+        return false;
+    case 4:
+        initBuffers(sunResource, noLightsPipeline);
+        return false;
+    case 5:
+        initBuffers(skyBoxResource, skyBoxPipeline);
+        return false;
+    default:
+        initEntities();
+        return true;
+    }
+}
+
+void GameScene::initEntities()
+{
+    fullScreenTarget = device->createRenderTarget(1, 1280, 720, true);
+    overviewScreenTarget = device->createRenderTarget(1, 640, 720, true);
+    earthScreenTarget = device->createRenderTarget(1, 640, 360, true);
+    spaceShipScreenTarget = device->createRenderTarget(1, 640, 360, true);
+
+    overviewCamera = createPerspectiveCamera(0, 0, 620, 700, overviewScreenTarget);
+	spaceShipCamera = createPerspectiveCamera(0, 0, 620, 340, spaceShipScreenTarget);
+	earthCamera = createPerspectiveCamera(0, 0, 620, 340, earthScreenTarget);
 
     fullscreenCamera = createOrthoCamera(0, 0, 1280, 720);
 
@@ -59,23 +136,45 @@ GameScene::GameScene(sge::Spade* engine) :
 
 GameScene::~GameScene()
 {
+    // load() has always finished, but the engine can quit before prepare() is done.
+    sge::ResourceManager::getMgr().release(vertexShaderResource);
+    sge::ResourceManager::getMgr().release(pixelShaderResource);
+    sge::ResourceManager::getMgr().release(skyBoxVertexShaderResource);
+    sge::ResourceManager::getMgr().release(skyBoxPixelShaderResource);
+    sge::ResourceManager::getMgr().release(noLightsVertexShaderResource);
+    sge::ResourceManager::getMgr().release(noLightsPixelShaderResource);
+    sge::ResourceManager::getMgr().release(skyBoxTextureResource);
     sge::ResourceManager::getMgr().release(earthResource);
     sge::ResourceManager::getMgr().release(sunResource);
     sge::ResourceManager::getMgr().release(skyBoxResource);
 	sge::ResourceManager::getMgr().release(spaceShipResource);
 	sge::ResourceManager::getMgr().release(moonResource);
 
-    device->deleteCubeMap(skyBoxCubeMap);
-
-    device->deleteShader(vertexShader);
-    device->deleteShader(pixelShader);
-    device->deleteShader(skyBoxPixelShader);
-    device->deleteShader(skyBoxVertexShader);
+    // Frees what the prepare() steps that ran have created, initPipelines() is the first step
+    // and initEntities() the last.
+    if (prepareStep > 0)
+    {
+        device->deletePipeline(pipeline);
+        device->deletePipeline(skyBoxPipeline);
+        device->deletePipeline(noLightsPipeline);
+
+        device->deleteShader(vertexShader);
+        device->deleteShader(pixelShader);
+        device->deleteShader(skyBoxPixelShader);
+        device->deleteShader(skyBoxVertexShader);
+        device->deleteShader(noLightsVertexShader);
+        device->deleteShader(noLightsPixelShader);
+    }
 
-    device->deletePipeline(pipeline);
-    device->deletePipeline(skyBoxPipeline);
+    if (prepareStep > 6)
+    {
+        device->deleteCubeMap(skyBoxCubeMap);
 
-	device->deleteRenderTarget(fullScreenTarget);
+        device->deleteRenderTarget(fullScreenTarget);
+        device->deleteRenderTarget(overviewScreenTarget);
+        device->deleteRenderTarget(earthScreenTarget);
+        device->deleteRenderTarget(spaceShipScreenTarget);
+    }
 }
 
 void GameScene::update(float step)
@@ -110,66 +209,27 @@ void GameScene::update(float step)
 	earthCamera->getComponent<sge::TransformComponent>()->setPosition(earth->getComponent<sge::TransformComponent>()->getPosition() - earth->getComponent<sge::TransformComponent>()->getFront() * 2.0f);
 	earthCamera->getComponent<sge::CameraComponent>()->update();
 
-	moon->getComponent<sge::TransformComponent>()->setPosition(earth->getComponent<sge::TransformComponent>()->getPosition() + sge::math::vec3(cos(alpha * 3.0f), 0.0f, sin(alpha * 3.0f)));
+	// Moon orbits in earth's space, which spins by alpha and is scaled by half.
+	moon->getComponent<sge::TransformComponent>()->setPosition(sge::math::vec3(2.0f * cos(alpha * 4.0f), 0.0f, 2.0f * sin(alpha * 4.0f)));
 	moon->getComponent<sge::TransformComponent>()->addAngle(0.05f);
 }
 
 void GameScene::draw()
 {
-	// Render overview camera.
-	renderer->addCameras(1, &overviewCamera);
-	renderer->setRenderTarget(overviewScreenTarget);
+	// One view per camera. The planet cameras draw the world layer into their targets and the
+	// fullscreen camera, added last, puts the targets on the screen.
+	sge::Entity* cameras[] = { overviewCamera, earthCamera, spaceShipCamera, fullscreenCamera };
+	sge::Entity* models[] = { earth, sun, skybox, spaceShip, moon };
+	sge::Entity* screens[] = { overviewScreen, earthScreen, spaceShipScreen };
 
-    renderer->clear(sge::COLOR);
+	renderer->addCameras(4, cameras);
 
     renderer->begin();
     renderer->renderLights(1, &sun);
-    renderer->renderModels(1, &earth);
-    renderer->renderModels(1, &sun);
-    renderer->renderModels(1, &skybox);
-	renderer->renderModels(1, &spaceShip);
-	renderer->renderModels(1, &moon);
+    renderer->renderModels(5, models);
+	renderer->renderSprites(3, screens);
     renderer->end();
 
-    renderer->render();
-
-	// Render earth camera.
-	renderer->clear(sge::CAMERAS | sge::RENDERTARGET);
-	renderer->addCameras(1, &earthCamera);
-	renderer->setRenderTarget(earthScreenTarget);
-	renderer->clear(sge::COLOR);
-
-	renderer->render();
-
-	// Render spaceship camera.
-	renderer->clear(sge::CAMERAS | sge::RENDERTARGET);
-	renderer->addCameras(1, &spaceShipCamera);
-	renderer->setRenderTarget(spaceShipScreenTarget);
-	renderer->clear(sge::COLOR);
-
-	renderer->render();
-
-	// Render cameras.
-	renderer->clear();
-	renderer->addCameras(1, &fullscreenCamera);
-	//renderer->setRenderTarget(fullScreenTarget);
-
-	renderer->begin();
-	renderer->renderSprites(1, &overviewScreen);
-	renderer->renderSprites(1, &earthScreen);
-	renderer->renderSprites(1, &spaceShipScreen);
-	renderer->end();
-
-	//renderer->render();
-
-	//// Render fullscreen.
-	//renderer->clear();
- //   renderer->addCameras(1, &fullscreenCamera);
-
- //   renderer->begin();
- //   renderer->renderSprites(1, &fullScreen);
- //   renderer->end();
-
     renderer->render();
     renderer->present();
     renderer->clear();
@@ -197,7 +257,7 @@ sge::Entity* GameScene::createEarth()
     return entity;
 }
 
-sge::Entity* GameScene::createPerspectiveCamera(int x, int y, unsigned int width, unsigned int height)
+sge::Entity* GameScene::createPerspectiveCamera(int x, int y, unsigned int width, unsigned int height, sge::RenderTarget* target)
 {
     sge::Entity* entity = entityManager.createEntity();
 
@@ -210,6 +270,8 @@ sge::Entity* GameScene::createPerspectiveCamera(int x, int y, unsigned int width
 
     camera->setPerspective(60.0f, (float)width / height, 0.1f, 1000.0f);
     camera->setViewport(x, y, width, height);
+    camera->setRenderTarget(target);
+    camera->setLayerMask(1u << WORLD_LAYER);
 
     return entity;
 }
@@ -227,6 +289,7 @@ sge::Entity* GameScene::createOrthoCamera(int x, int y, unsigned int width, unsi
 
     cameracomponent->setOrtho(0.0f, (float)width, 0.0f, (float)height, 0.1f, 1000.0f);
     cameracomponent->setViewport(x, y, width, height);
+    cameracomponent->setLayerMask(1u << SCREEN_LAYER);
 
     return entity;
 }
@@ -282,15 +345,11 @@ sge::Entity* GameScene::createSun()
 
 sge::Entity* GameScene::createSkyBox()
 {
-    sge::Handle<sge::TextureResource> texture;
-
-    texture = sge::ResourceManager::getMgr().load<sge::TextureResource>("../Assets/CubeMap/space.png");
-
     sge::TextureResource* source[6];
 
     for (size_t i = 0; i < 6; i++)
     {
-        source[i] = texture.getResource<sge::TextureResource>();
+        source[i] = skyBoxTextureResource.getResource<sge::TextureResource>();
     }
 
     device->bindPipeline(skyBoxPipeline);
@@ -311,6 +370,9 @@ sge::Entity* GameScene::createSkyBox()
     model->setModelResource(&skyBoxResource);
     model->setCubeMap(skyBoxCubeMap);
 
+    // The sky box shader ignores the model matrix and is drawn around the camera.
+    model->setFrustumCulling(false);
+
     device->debindPipeline(skyBoxPipeline);
 
     return entity;
@@ -329,6 +391,7 @@ sge::Entity* GameScene::createSprite(int x, int y, unsigned int width, unsigned
 
     sprite->setTexture(texture);
     sprite->setColor({ 1.0f, 1.0f, 1.0f, 1.0f });
+    sprite->setLayer(SCREEN_LAYER);
 
     return entity;
 }
@@ -365,8 +428,10 @@ sge::Entity* GameScene::createMoon()
 	auto transform = transformFactory.create(entity);
 	auto model = modelFactory.create(entity);
 
-	transform->setPosition({ 0.0f, 0.0f, 6.0f });
-	transform->setScale({ 0.1f, 0.1f, 0.1f });
+	// Relative to the earth.
+	transform->setParentTransform(earth->getComponent<sge::TransformComponent>());
+	transform->setPosition({ 2.0f, 0.0f, 0.0f });
+	transform->setScale({ 0.2f, 0.2f, 0.2f });
 
 	model->setPipeline(pipeline);
 	model->setShininess(2.0f);
@@ -380,39 +445,14 @@ sge::Entity* GameScene::createMoon()
 
 void GameScene::initPipelines()
 {
-    sge::Handle<sge::ShaderResource> pixelShaderHandle;
-    sge::Handle<sge::ShaderResource> vertexShaderHandle;
-
-    sge::Handle<sge::ShaderResource> skyBoxPixelShaderHandle;
-    sge::Handle<sge::ShaderResource> skyBoxVertexShaderHandle;
+    const std::vector<char>& vertexShaderData = vertexShaderResource.getResource<sge::ShaderResource>()->loadShader();
+    const std::vector<char>& pixelShaderData = pixelShaderResource.getResource<sge::ShaderResource>()->loadShader();
 
-    sge::Handle<sge::ShaderResource> noLightsVertexShaderHandle;
-    sge::Handle<sge::ShaderResource> noLightsPixelShaderHandle;
+    const std::vector<char>& vertexShaderData2 = skyBoxVertexShaderResource.getResource<sge::ShaderResource>()->loadShader();
+    const std::vector<char>& pixelShaderData2 = skyBoxPixelShaderResource.getResource<sge::ShaderResource>()->loadShader();
 
-#ifdef DIRECTX11
-    vertexShaderHandle = sge::ResourceManager::getMgr().load<sge::ShaderResource>("../Assets/Shaders/VertexShaderLights.cso");
-    pixelShaderHandle = sge::ResourceManager::getMgr().load<sge::ShaderResource>("../Assets/Shaders/PixelShaderLights.cso");
-    skyBoxVertexShaderHandle = sge::ResourceManager::getMgr().load<sge::ShaderResource>("../Assets/Shaders/VertexSkyBox.cso");
-    skyBoxPixelShaderHandle = sge::ResourceManager::getMgr().load<sge::ShaderResource>("../Assets/Shaders/PixelSkyBox.cso");
-    noLightsVertexShaderHandle = sge::ResourceManager::getMgr().load<sge::ShaderResource>("../Assets/Shaders/VertexShaderNoLights.cso");
-    noLightsPixelShaderHandle = sge::ResourceManager::getMgr().load<sge::ShaderResource>("../Assets/Shaders/PixelShaderNoLights.cso");
-#elif OPENGL4
-    vertexShaderHandle = sge::ResourceManager::getMgr().load<sge::ShaderResource>("../Assets/Shaders/VertexShaderLights.glsl");
-    pixelShaderHandle = sge::ResourceManager::getMgr().load<sge::ShaderResource>("../Assets/Shaders/PixelShaderLights.glsl");
-    skyBoxVertexShaderHandle = sge::ResourceManager::getMgr().load<sge::ShaderResource>("../Assets/Shaders/VertexSkyBox.glsl");
-    skyBoxPixelShaderHandle = sge::ResourceManager::getMgr().load<sge::ShaderResource>("../Assets/Shaders/PixelSkyBox.glsl");
-    noLightsVertexShaderHandle = sge::ResourceManager::getMgr().load<sge::ShaderResource>("../Assets/Shaders/VertexShaderNoLights.glsl");
-    noLightsPixelShaderHandle = sge::ResourceManager::getMgr().load<sge::ShaderResource>("../Assets/Shaders/PixelShaderNoLights.glsl");
-#endif
-
-    const std::vector<char>& vertexShaderData = vertexShaderHandle.getResource<sge::ShaderResource>()->loadShader();
-    const std::vector<char>& pixelShaderData = pixelShaderHandle.getResource<sge::ShaderResource>()->loadShader();
-
-    const std::vector<char>& vertexShaderData2 = skyBoxVertexShaderHandle.getResource<sge::ShaderResource>()->loadShader();
-    const std::vector<char>& pixelShaderData2 = skyBoxPixelShaderHandle.getResource<sge::ShaderResource>()->loadShader();
-
-    const std::vector<char>& vertexShaderData3 = noLightsVertexShaderHandle.getResource<sge::ShaderResource>()->loadShader();
-    const std::vector<char>& pixelShaderData3 = noLightsPixelShaderHandle.getResource<sge::ShaderResource>()->loadShader();
+    const std::vector<char>& vertexShaderData3 = noLightsVertexShaderResource.getResource<sge::ShaderResource>()->loadShader();
+    const std::vector<char>& pixelShaderData3 = noLightsPixelShaderResource.getResource<sge::ShaderResource>()->loadShader();
 
     vertexShader = device->createShader(sge::ShaderType::VERTEX, vertexShaderData.data(), vertexShaderData.size());
     pixelShader = device->createShader(sge::ShaderType::PIXEL, pixelShaderData.data(), pixelShaderData.size());
@@ -437,39 +477,12 @@ void GameScene::initPipelines()
     noLightsPipeline = device->createPipeline(&vertexLayoutDescription, noLightsVertexShader, noLightsPixelShader);
 }
 
-void GameScene::initResources()
+void GameScene::initBuffers(sge::Handle<sge::ModelResource>& resource, sge::Pipeline* pipeline)
 {
     device->bindPipeline(pipeline);
-    earthResource = sge::ResourceManager::getMgr().load<sge::ModelResource>("../Assets/liteEarthDiffuseSpecular.dae");
-    earthResource.getResource<sge::ModelResource>()->setDevice(device);
-    earthResource.getResource<sge::ModelResource>()->createBuffers();
-
-	spaceShipResource = sge::ResourceManager::getMgr().load<sge::ModelResource>("../Assets/SpaceShip.dae");
-	spaceShipResource.getResource<sge::ModelResource>()->setDevice(device);
-	spaceShipResource.getResource<sge::ModelResource>()->createBuffers();
-
-	moonResource = sge::ResourceManager::getMgr().load<sge::ModelResource>("../Assets/moonSphere.dae");
-	moonResource.getResource<sge::ModelResource>()->setDevice(device);
-	moonResource.getResource<sge::ModelResource>()->createBuffers();
-
+    resource.getResource<sge::ModelResource>()->setDevice(device);
+    resource.getResource<sge::ModelResource>()->createBuffers();
     device->debindPipeline(pipeline);
-
-    device->bindPipeline(noLightsPipeline);
-    sunResource = sge::ResourceManager::getMgr().load<sge::ModelResource>("../Assets/sunSphere.dae");
-    sunResource.getResource<sge::ModelResource>()->setDevice(device);
-    sunResource.getResource<sge::ModelResource>()->createBuffers();
-    device->debindPipeline(noLightsPipeline);
-
-    device->bindPipeline(skyBoxPipeline);
-    skyBoxResource = sge::ResourceManager::getMgr().load<sge::ModelResource>("../Assets/SkyBox.dae");
-    skyBoxResource.getResource<sge::ModelResource>()->setDevice(device);
-    skyBoxResource.getResource<sge::ModelResource>()->createBuffers();
-    device->debindPipeline(skyBoxPipeline);
-
-    fullScreenTarget = device->createRenderTarget(1, 1280, 720, true);
-	overviewScreenTarget = device->createRenderTarget(1, 640, 720, true);
-	earthScreenTarget = device->createRenderTarget(1, 640, 360, true);
-	spaceShipScreenTarget = device->createRenderTarget(1, 640, 360, true);
 }
 
 void GameScene::interpolate(float alpha)
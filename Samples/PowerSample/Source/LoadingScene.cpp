@@ -0,0 +1,31 @@
+#include "LoadingScene.h"
+#include "GameScene.h"
+
+#include "Game/RenderSystem.h"
+
+#include "Spade/Spade.h"
+
+LoadingScene::LoadingScene(sge::Spade* engine) :
+    engine(engine)
+{
+    // The game scene reads its files on the loader thread and replaces this scene once it's ready.
+    engine->getSceneManager()->changeAsync(new GameScene(engine));
+}
+
+void LoadingScene::update(float)
+{
+    if (engine->keyboardInput->keyIsPressed(sge::KEYBOARD_ESCAPE))
+    {
+        engine->stop();
+    }
+}
+
+void LoadingScene::interpolate(float)
+{
+}
+
+void LoadingScene::draw()
+{
+    engine->getRenderer()->clear(sge::COLOR);
+    engine->getRenderer()->present();
+}
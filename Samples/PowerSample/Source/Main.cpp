@@ -1,12 +1,12 @@
 #include "Spade/Spade.h"
-#include "GameScene.h"
+#include "LoadingScene.h"
 
 int main(int argc, char** argv)
 {
     sge::Spade spade;
 
     spade.init();
-    spade.run(new GameScene(&spade));
+    spade.run(new LoadingScene(&spade));
     spade.quit();
 
     return 0;
@@ -0,0 +1,255 @@
+#include "Renderer/RenderQueue.h"
+#include "Core/Random.h"
+#include "Core/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Headless RenderQueue benchmark. Prints the results as JSON to stdout.
+//
+// Usage: QueueSample [--repeat n] [command count...]
+//
+// Compares the radix sort of RenderQueue::end with the std::sort the queue used before,
+// and recording from one thread with recording into per thread segments.
+
+namespace
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	const char* const CASES[] =
+	{
+		"std_sort",
+		"radix_sort",
+		"radix_sort_parallel",
+		"record",
+		"record_parallel"
+	};
+
+	enum Case
+	{
+		STD_SORT,
+		RADIX_SORT,
+		RADIX_SORT_PARALLEL,
+		RECORD,
+		RECORD_PARALLEL,
+		CASE_COUNT
+	};
+
+	class Timer
+	{
+	public:
+		Timer() : start(Clock::now())
+		{
+		}
+
+		double seconds() const
+		{
+			return std::chrono::duration<double>(Clock::now() - start).count();
+		}
+
+	private:
+		Clock::time_point start;
+	};
+
+	void pushSprite(sge::RenderQueue::Segment& segment, uint64 key)
+	{
+		sge::RenderCommand command;
+		command.bits = key;
+
+		sge::DrawSpritePacket& packet = segment.push<sge::DrawSpritePacket>(command);
+		packet.pipeline = nullptr;
+		packet.texture = nullptr;
+		packet.view = 0;
+		packet.MVP = sge::math::mat4(1.0f);
+		packet.color = sge::math::vec4(1.0f);
+	}
+
+	// Fills the queue from every segment at once, one pool task per segment.
+	void recordParallel(sge::ThreadPool& pool, sge::RenderQueue& queue, const std::vector<uint64>& keys)
+	{
+		size_t segmentCount = queue.getSegmentCount();
+
+		pool.dispatch(segmentCount, [&](size_t index)
+		{
+			sge::RenderQueue::Segment& segment = queue.getSegment(index);
+			size_t begin = keys.size() * index / segmentCount;
+			size_t end = keys.size() * (index + 1) / segmentCount;
+
+			for (size_t i = begin; i < end; i++)
+			{
+				pushSprite(segment, keys[i]);
+			}
+		});
+	}
+
+	bool isSorted(const sge::RenderQueue& queue)
+	{
+		const std::vector<sge::RenderQueue::Item>& items = queue.getItems();
+
+		for (size_t i = 1; i < items.size(); i++)
+		{
+			if (items[i - 1].key > items[i].key)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Every case timed once with the same keys. Returns false if a sort gave a wrong order.
+	bool runOnce(sge::ThreadPool& pool, const std::vector<uint64>& keys, double* seconds)
+	{
+		const size_t count = keys.size();
+
+		{
+			// The comparison of the previous RenderQueue::sort.
+			std::vector<sge::RenderQueue::Item> items(count);
+
+			for (size_t i = 0; i < count; i++)
+			{
+				items[i].key = keys[i];
+				items[i].offset = static_cast<uint32>(i * sizeof(sge::DrawSpritePacket));
+			}
+
+			Timer timer;
+
+			std::sort(items.begin(), items.end(), [](const sge::RenderQueue::Item& lhs, const sge::RenderQueue::Item& rhs)
+			{
+				return lhs.key < rhs.key || (lhs.key == rhs.key && lhs.offset < rhs.offset);
+			});
+
+			seconds[STD_SORT] = timer.seconds();
+		}
+
+		bool sorted = true;
+
+		{
+			sge::RenderQueue queue(count);
+			queue.begin();
+
+			Timer recordTimer;
+
+			for (size_t i = 0; i < count; i++)
+			{
+				pushSprite(queue.getSegment(0), keys[i]);
+			}
+
+			seconds[RECORD] = recordTimer.seconds();
+
+			Timer sortTimer;
+			queue.end();
+			seconds[RADIX_SORT] = sortTimer.seconds();
+
+			sorted = sorted && isSorted(queue);
+		}
+
+		{
+			size_t segmentCount = pool.getWorkerCount() + 1;
+
+			sge::RenderQueue queue(count / segmentCount + 1, segmentCount);
+			queue.setThreadPool(&pool);
+			queue.begin();
+
+			Timer recordTimer;
+			recordParallel(pool, queue, keys);
+			seconds[RECORD_PARALLEL] = recordTimer.seconds();
+
+			Timer sortTimer;
+			queue.end();
+			seconds[RADIX_SORT_PARALLEL] = sortTimer.seconds();
+
+			sorted = sorted && isSorted(queue);
+		}
+
+		return sorted;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	size_t repeat = 5;
+	std::vector<size_t> counts;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg(argv[i]);
+
+		if (arg == "--repeat" && i + 1 < argc)
+		{
+			repeat = std::max<size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+		}
+		else
+		{
+			counts.push_back(std::strtoul(argv[i], nullptr, 10));
+		}
+	}
+
+	if (counts.empty())
+	{
+		counts = { 1000, 10000, 100000 };
+	}
+
+	sge::ThreadPool pool(sge::ThreadPool::getDefaultWorkerCount());
+	sge::RandomGenerator random(1);
+	bool sorted = true;
+
+	std::printf("{\n  \"benchmark\": \"render_queue\",\n  \"repeat\": %u,\n  \"threads\": %u,\n  \"results\": [\n",
+		static_cast<unsigned>(repeat),
+		static_cast<unsigned>(pool.getWorkerCount() + 1));
+
+	for (size_t c = 0; c < counts.size(); c++)
+	{
+		// Random keys, so every byte of the key needs a radix pass.
+		std::vector<uint64> keys(counts[c]);
+
+		for (auto& key : keys)
+		{
+			key = (static_cast<uint64>(random.next()) << 32) | random.next();
+		}
+
+		std::vector<std::vector<double>> runs(CASE_COUNT, std::vector<double>(repeat));
+		double seconds[CASE_COUNT];
+
+		for (size_t r = 0; r < repeat; r++)
+		{
+			sorted = runOnce(pool, keys, seconds) && sorted;
+
+			for (size_t i = 0; i < CASE_COUNT; i++)
+			{
+				runs[i][r] = seconds[i];
+			}
+		}
+
+		for (size_t i = 0; i < CASE_COUNT; i++)
+		{
+			std::vector<double>& run = runs[i];
+			std::sort(run.begin(), run.end());
+
+			double median = run[run.size() / 2];
+			bool last = c + 1 == counts.size() && i + 1 == CASE_COUNT;
+
+			std::printf("    { \"case\": \"%s\", \"commands\": %u, \"median_ms\": %.4f, \"min_ms\": %.4f, \"ns_per_command\": %.2f }%s\n",
+				CASES[i],
+				static_cast<unsigned>(counts[c]),
+				median * 1000.0,
+				run.front() * 1000.0,
+				median * 1e9 / std::max<size_t>(1, counts[c]),
+				last ? "" : ",");
+		}
+	}
+
+	std::printf("  ]\n}\n");
+
+	if (!sorted)
+	{
+		std::fprintf(stderr, "RenderQueue produced an unsorted queue.\n");
+		return 1;
+	}
+
+	return 0;
+}
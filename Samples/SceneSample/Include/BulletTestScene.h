@@ -8,7 +8,9 @@
 
 #include <Bullet/btBulletDynamicsCommon.h>
 
+#include "Game/ComponentFactory.h"
 #include "Game/EntityManager.h"
+#include "Game/Prefab.h"
 #include "Game/SystemManager.h"
 #include "Game/CameraComponent.h"
 #include "Game/ModelComponent.h"
@@ -34,6 +36,43 @@ struct UniformData2
 	sge::math::mat4 M;
 };
 
+namespace sge
+{
+	class TransformComponent;
+
+	class MyPhysicsComponent : public Component
+	{
+	public:
+		MyPhysicsComponent(Entity* ent) : Component(ent), transform(nullptr), body(nullptr)
+		{
+			transform = getParent()->getComponent<TransformComponent>();
+
+			SGE_ASSERT(transform);
+		}
+
+		void update()
+		{
+			btTransform trans;
+			if (body != nullptr)
+			{
+				body->getMotionState()->getWorldTransform(trans);
+
+				getParent()->getComponent<sge::TransformComponent>()->setPosition(sge::math::vec3(trans.getOrigin().getX(), trans.getOrigin().getY(), trans.getOrigin().getZ()));
+				getParent()->getComponent<sge::TransformComponent>()->setAngle(trans.getRotation().getAngle());
+				getParent()->getComponent<sge::TransformComponent>()->setRotationVector(sge::math::vec3(trans.getRotation().getAxis().getX(), trans.getRotation().getAxis().getY(), trans.getRotation().getAxis().getZ()));
+			}			
+		};
+
+		void setRigidBody(btRigidBody* body)
+		{
+			this->body = body;
+		}
+	private:
+		btRigidBody* body;
+		TransformComponent* transform;
+	};
+}
+
 class BulletTestScene : public sge::Scene
 {
 public:
@@ -171,6 +210,12 @@ private:
 
 	std::vector<sge::Entity*> GameObjects;
 
+	// Objects spawned at runtime are instantiated from the prefab, the factories own their components.
+	sge::ComponentFactory<sge::TransformComponent> spawnTransforms;
+	sge::ComponentFactory<sge::ModelComponent> spawnModels;
+	sge::ComponentFactory<sge::MyPhysicsComponent> spawnPhysics;
+	sge::Prefab spawnPrefab;
+
 	float alpha;
 
 	void spawnObject(sge::math::vec3 pos);
@@ -178,41 +223,3 @@ private:
 	bool played;
 	bool coop;
 };
-
-namespace sge
-{
-	class TransformComponent;
-
-	class MyPhysicsComponent : public Component
-	{
-	public:
-		MyPhysicsComponent(Entity* ent) : Component(ent), transform(nullptr), body(nullptr)
-		{
-			transform = getParent()->getComponent<TransformComponent>();
-
-			SGE_ASSERT(transform);
-		}
-
-		void update()
-		{
-			btTransform trans;
-			if (body != nullptr)
-			{
-				body->getMotionState()->getWorldTransform(trans);
-
-				getParent()->getComponent<sge::TransformComponent>()->setPosition(sge::math::vec3(trans.getOrigin().getX(), trans.getOrigin().getY(), trans.getOrigin().getZ()));
-				getParent()->getComponent<sge::TransformComponent>()->setAngle(trans.getRotation().getAngle());
-				getParent()->getComponent<sge::TransformComponent>()->setRotationVector(sge::math::vec3(trans.getRotation().getAxis().getX(), trans.getRotation().getAxis().getY(), trans.getRotation().getAxis().getZ()));
-			}			
-		};
-
-		void setRigidBody(btRigidBody* body)
-		{
-			this->body = body;
-		}
-	private:
-		btRigidBody* body;
-		TransformComponent* transform;
-	};
-}
-
@@ -100,24 +100,8 @@ void BulletTestScene::loadBinaryShader(const std::string& path, std::vector<char
 
 void BulletTestScene::spawnObject(sge::math::vec3 pos)
 {
-	EManager = new sge::EntityManager();
-
-	sge::Entity* modentity = EManager->createEntity();
-
-	sge::TransformComponent* modtransform = new sge::TransformComponent(modentity);
-	modentity->setComponent(modtransform);
-
-	sge::ModelComponent* modcomponent = new sge::ModelComponent(modentity);
-	modcomponent->setShininess(15.0f);
-	modentity->setComponent(modcomponent);
-
-	modcomponent->setModelResource(&modelHandle2);
-	modcomponent->setRenderer(engine->getRenderer());
-
-	modentity->getComponent<sge::TransformComponent>()->setPosition(pos);
-	modentity->getComponent<sge::TransformComponent>()->setRotationVector(glm::vec3(0.0f, 0.0f, 1.0f));
-
-	modcomponent->setPipeline(pipelineNormals);
+	sge::PrefabTransform placement(pos);
+	sge::Entity* modentity = spawnPrefab.instantiate(*EManager, 1, &placement)[0];
 
 	btDefaultMotionState* fallMotionState =
 		new btDefaultMotionState(btTransform(btQuaternion(0, 0, 0, 1), btVector3(pos.x, pos.y, pos.z)));
@@ -131,9 +115,7 @@ void BulletTestScene::spawnObject(sge::math::vec3 pos)
 	spawnRigidBody->setActivationState(DISABLE_DEACTIVATION);
 	dynamicsWorld->addRigidBody(spawnRigidBody);
 
-	sge::MyPhysicsComponent* physcomponent = new sge::MyPhysicsComponent(modentity);
-	physcomponent->setRigidBody(spawnRigidBody);
-	modentity->setComponent(physcomponent);
+	modentity->getComponent<sge::MyPhysicsComponent>()->setRigidBody(spawnRigidBody);
 
 	// GameObject vector
 	GameObjects.push_back(modentity);
@@ -233,6 +215,19 @@ BulletTestScene::BulletTestScene(sge::Spade* engine) : engine(engine), renderer(
 	// For spawning objects
 	spawnShape = new btBoxShape(btVector3(1, 1, 1));
 
+	spawnPrefab.add(spawnTransforms)->setRotationVector(glm::vec3(0.0f, 0.0f, 1.0f));
+
+	// The model members aren't reflected, so they're set for every instance.
+	spawnPrefab.add<sge::ModelComponent>(spawnModels, [this](sge::ModelComponent* model)
+	{
+		model->setShininess(15.0f);
+		model->setModelResource(&modelHandle2);
+		model->setRenderer(renderer);
+		model->setPipeline(pipelineNormals);
+	});
+
+	spawnPrefab.add(spawnPhysics);
+
 	//-------------------------
 	// Model 1
 	EManager = new sge::EntityManager();
@@ -0,0 +1,25 @@
+#version 440 core
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec2 inTexCoords;
+
+out vec2 outTexCoords;
+out vec4 outColor;
+
+struct SpriteInstance
+{
+	mat4 MVP;
+	vec4 color;
+};
+
+layout (std140, binding = 0) uniform instanceUniform
+{
+	SpriteInstance instances[128];
+};
+
+void main()
+{
+	gl_Position = instances[gl_InstanceID].MVP * vec4(inPosition, 1.0);
+	outTexCoords = inTexCoords;
+	outColor = instances[gl_InstanceID].color;
+}
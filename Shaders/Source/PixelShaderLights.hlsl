@@ -4,6 +4,7 @@ Texture2D specularTex;
 float shininess = 0.9;
 
 #define NUM_POINT_LIGHTS 40
+#define NUM_DIR_LIGHTS 10
 
 struct VOut
 {
@@ -27,26 +28,41 @@ struct PointLight
 {
 	float4 position;
 
-	float constant;
-	float mylinear;
-	float quadratic;
-
 	float4 ambient;
 	float4 diffuse;
 	float4 specular;
+
+	float constant;
+	float mylinear;
+	float quadratic;
 	float pad;
 };
 
 float3 CalculateDirectionLight(DirLight light, float3 normal, float3 viewDir, VOut vout);
 float3 CalculatePointLight(PointLight light, float3 normal, float3 fragPos, float3 viewDir, VOut vout);
 
-cbuffer UniformData : register(b1)
+cbuffer FrameData : register(b1)
 {
-	DirLight dirLight;
+	DirLight dirLights[NUM_DIR_LIGHTS];
 	PointLight pointLights[NUM_POINT_LIGHTS];
+	float numofpl;
+	float numofdl;
+	float numofsl;
+	float pad;
+};
+
+cbuffer CameraData : register(b2)
+{
 	float4 viewPos;
-	int numofpl;
-	int pad[3];
+};
+
+cbuffer MaterialData : register(b3)
+{
+	float glossyness;
+	int hasDiffuseTex;
+	int hasNormalTex;
+	int hasSpecularTex;
+	int hasCubeTex;
 };
 
 SamplerState textureSampler;
@@ -60,9 +76,12 @@ float4 main(VOut vout) : SV_TARGET
 	
 	float3 viewDir = mul(vout.TBNVout , normalize(viewPos.xyz - vout.fragPos));
 
-	float3 result = CalculateDirectionLight(dirLight, normal, viewDir, vout);
+	float3 result = float3(0.0, 0.0, 0.0);
+
+	for (int d = 0; d < (int)numofdl; d++)
+		result += CalculateDirectionLight(dirLights[d], normal, viewDir, vout);
 	
-	for (int i = 0; i < numofpl; i++)
+	for (int i = 0; i < (int)numofpl; i++)
 		result += CalculatePointLight(pointLights[i], normal, vout.fragPos, viewDir, vout);
 
 	return float4(result, 1.0);
@@ -0,0 +1,15 @@
+Texture2D tex;
+
+struct VOut
+{
+	float4 position : SV_POSITION;
+    float2 texcoords : TEXCOORD0;
+    float4 color : COLOR0;
+};
+
+SamplerState textureSampler;
+
+float4 main(VOut vout) : SV_TARGET
+{
+    return vout.color * tex.Sample(textureSampler, vout.texcoords);
+}
@@ -0,0 +1,31 @@
+struct VOut
+{
+	float4 position : SV_POSITION;
+    float2 texcoords : TEXCOORD0;
+    float4 color : COLOR0;
+};
+
+struct SpriteInstance
+{
+	float4x4 MVP;
+	float4 color;
+};
+
+cbuffer InstanceData : register(b0)
+{
+	SpriteInstance instances[128];
+}
+
+VOut main(
+	float4 position : POSITION0,
+    float2 texcoords : TEXCOORD0,
+    uint instance : SV_InstanceID)
+{
+	VOut output;
+
+	output.position = mul(instances[instance].MVP, position);
+    output.texcoords = texcoords;
+    output.color = instances[instance].color;
+
+	return output;
+}
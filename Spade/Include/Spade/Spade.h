@@ -2,10 +2,15 @@
 
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include "Renderer/Window.h"
 #include "Resources/ResourceManager.h"
 
 #include "Game/EventManager.h"
+#include "Game/FrameSnapshot.h"
 #include "Game/RenderSystem.h"
 #include "Game/SceneManager.h"
 
@@ -16,13 +21,66 @@ namespace sge
 	class Spade
 	{
 	public:
-		Spade();
+		/** \brief The constructor.
+		*
+		* A headless engine creates no window or graphics context. Scenes still draw, but the
+		* renderer uses a NullGraphicsDevice that drops every call, so simulation and the CPU
+		* side of rendering can run on machines without a display or GPU.
+		* \param bool headless : True to run headless.
+		*/
+		Spade(bool headless = false);
 		~Spade();
 
 		void init();
 		void run(Scene* scene);
 		void stop(){ running = false; }
 
+		/** \brief Overlaps the simulation of the next frame with drawing the current one.
+		*
+		* The fixed steps, interpolate() and Scene::snapshot run on a simulation thread while
+		* draw() runs on the main thread, which owns the graphics context, and draws the snapshot
+		* of the previous frame. The frames are shown one frame later than serially. Scenes that
+		* don't take snapshots keep running serially, as does the first frame of a scene.
+		* \param bool enabled : True to pipeline.
+		*/
+		void setPipelined(bool enabled)
+		{
+			pipelined = enabled;
+		}
+
+		bool isPipelined() const
+		{
+			return pipelined;
+		}
+
+		bool isHeadless() const
+		{
+			return headless;
+		}
+
+		/** \brief Sets how a headless engine paces its frames.
+		*
+		* Every headless frame advances the scenes by exactly one step. Throttled frames are
+		* spaced a step apart in real time, unthrottled ones run back to back. Unthrottled by default.
+		* \param bool enabled : True to throttle.
+		*/
+		void setThrottled(bool enabled)
+		{
+			throttled = enabled;
+		}
+
+		/** \brief Makes run() return after a number of frames, 0 for no limit. */
+		void setFrameLimit(size_t frames)
+		{
+			frameLimit = frames;
+		}
+
+		/** \brief Enables or disables calling draw() on the scenes. */
+		void setRenderingEnabled(bool enabled)
+		{
+			renderingEnabled = enabled;
+		}
+
 		void quit();
 
 		SceneManager* getSceneManager()
@@ -30,11 +88,29 @@ namespace sge
 			return sceneManager;
 		}
 
+		/** \brief Getter function for the input events, e.g. to record or replay them. */
+		EventManager* getEventManager()
+		{
+			return eventManager;
+		}
+
         RenderSystem* getRenderer()
 		{
 			return &renderer;
 		}
 
+		/** \brief Snapshot the active scene draws, see Scene::snapshot. Not changed until draw() returns. */
+		const FrameSnapshot& getFrameSnapshot() const
+		{
+			return snapshots[frontSnapshot];
+		}
+
+		/** \brief Worker pool of the engine, shared by scene loading and rendering. */
+		ThreadPool* getThreadPool()
+		{
+			return &pool;
+		}
+
 		const float getStep() const
 		{
 			return step;
@@ -49,14 +125,49 @@ namespace sge
 		void update(float deltaTime);
 		void draw();
 
+		/** \brief Updates the scenes and lets the active one fill the back snapshot. */
+		void simulate(float deltaTime);
+
+		/** \brief Makes the snapshot simulate() took the one getFrameSnapshot returns. */
+		void publishSnapshot();
+
+		/** \brief Time passed since the previous frame. Fixed for headless engines. */
+		float advanceClock(float& currentTime);
+
+		void startSimulation(float deltaTime);
+		void waitForSimulation();
+		void simulationLoop();
+		void stopSimulationThread();
+
 		sge::Window window;
         sge::RenderSystem renderer;
+		sge::ThreadPool pool;
 
 		sge::SceneManager* sceneManager;
 		sge::EventManager* eventManager;
 
-		bool running;
+		std::atomic<bool> running;	/**< Cleared by stop(), which scenes call from the simulation thread. */
 		float step;
 		float accumulator;
+
+		bool headless;
+		bool throttled;
+		bool renderingEnabled;
+		size_t frameLimit;
+		float frameTime;	/**< Time the current frame started at, in seconds. */
+
+		// Drawable state of the scenes, drawn from the front one while the back one is filled.
+		FrameSnapshot snapshots[2];
+		size_t frontSnapshot;
+		bool snapshotTaken;			/**< The active scene filled the back snapshot in the last simulate(). */
+
+		// Pipelined mode.
+		bool pipelined;
+		bool simulationPending;		/**< Set while the simulation thread has a frame to run. */
+		bool simulationStopping;
+		float simulationDelta;
+		std::thread simulationThread;
+		std::mutex simulationMutex;
+		std::condition_variable simulationChanged;
 	};
 };
\ No newline at end of file
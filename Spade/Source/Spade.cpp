@@ -3,14 +3,30 @@
 
 namespace sge
 {
-	Spade::Spade() : 
-        window("Spade Game Engine", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 1280, 720),
+	Spade::Spade(bool headless) : 
+        window("Spade Game Engine", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 1280, 720, headless),
         renderer(window),
+        pool(ThreadPool::getDefaultWorkerCount()),
         running(true), 
         accumulator(0.0f), 
-        step(0.0f)
+        step(0.0f),
+        headless(headless),
+        throttled(false),
+        renderingEnabled(true),
+        frameLimit(0),
+        frameTime(0.0f),
+        frontSnapshot(0),
+        snapshotTaken(false),
+        pipelined(false),
+        simulationPending(false),
+        simulationStopping(false),
+        simulationDelta(0.0f)
 	{
 #ifdef OPENGL4
+		if (headless)
+		{
+			return;
+		}
 
 		SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 8);
 		SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8);
@@ -35,22 +51,26 @@ namespace sge
 
 	Spade::~Spade()
 	{
+		stopSimulationThread();
 	}
 
 	void Spade::init()
 	{
 		renderer.init();
+		renderer.setThreadPool(&pool);
 		step = 1.0f / 60.0f;
 
 		mouseInput = new sge::MouseInput();
 		keyboardInput = new sge::KeyboardInput();
 		gamepadInput = new sge::GamepadInput();
 		eventManager = new EventManager(mouseInput, keyboardInput, gamepadInput);
-		sceneManager = new SceneManager();
+		sceneManager = new SceneManager(pool);
 	}
 
 	void Spade::quit()
 	{
+		stopSimulationThread();
+
 		delete eventManager;
 		delete sceneManager;
 		delete mouseInput;
@@ -63,24 +83,67 @@ namespace sge
 	void Spade::run(Scene* scene)
 	{
 		float deltaTime = 0.0f;
-		float newTime = 0.0f;
 		float currentTime = SDL_GetTicks() / 1000.0f;
+		size_t frames = 0;
 
 		sceneManager->change(scene);
 		sceneManager->handleScenes();
 
-		while (running)
+		while (running && (frameLimit == 0 || frames < frameLimit))
 		{
-			newTime = SDL_GetTicks() / 1000.0f;
-			deltaTime = std::min(newTime - currentTime, 0.25f);
-			currentTime = newTime;
+			deltaTime = advanceClock(currentTime);
+			frameTime = currentTime;
+			frames++;
 
 			handleEvents();
-			update(deltaTime);
-			draw();
 
-			sceneManager->handleScenes();
+			// Frame N is drawn from the front snapshot while frame N + 1 simulates and fills the
+			// back one. The first frame of a scene has nothing to draw yet, so it runs serially.
+			if (pipelined && snapshotTaken)
+			{
+				startSimulation(deltaTime);
+				draw();
+				waitForSimulation();
+				publishSnapshot();
+			}
+			else
+			{
+				simulate(deltaTime);
+				publishSnapshot();
+				draw();
+			}
+
+			if (sceneManager->handleScenes())
+			{
+				snapshotTaken = false;
+			}
+		}
+	}
+
+	float Spade::advanceClock(float& currentTime)
+	{
+		if (headless)
+		{
+			if (throttled)
+			{
+				float elapsed = SDL_GetTicks() / 1000.0f - currentTime;
+
+				if (elapsed < step)
+				{
+					SDL_Delay(static_cast<Uint32>((step - elapsed) * 1000.0f));
+				}
+
+				currentTime = SDL_GetTicks() / 1000.0f;
+			}
+
+			return step;
 		}
+
+		float newTime = SDL_GetTicks() / 1000.0f;
+		float deltaTime = std::min(newTime - currentTime, 0.25f);
+		currentTime = newTime;
+
+		return deltaTime;
 	}
 
 	void Spade::handleEvents()
@@ -99,6 +162,9 @@ namespace sge
 
 		while(accumulator >= step)
 		{
+			// Time the step catches the simulation up to, the input received before it belongs to the step.
+			float stepEnd = frameTime - (accumulator - step);
+			eventManager->beginStep(stepEnd, accumulator - step < step);
 			sceneManager->update(step);
 			accumulator -= step;
 
@@ -110,8 +176,88 @@ namespace sge
 		sceneManager->interpolate(accumulator / step);
 	}
 
+	void Spade::simulate(float deltaTime)
+	{
+		update(deltaTime);
+
+		FrameSnapshot& snapshot = snapshots[1 - frontSnapshot];
+		snapshot.clear();
+
+		snapshotTaken = sceneManager->snapshot(snapshot);
+	}
+
+	void Spade::publishSnapshot()
+	{
+		if (snapshotTaken)
+		{
+			frontSnapshot = 1 - frontSnapshot;
+		}
+	}
+
 	void Spade::draw()
 	{
-		sceneManager->draw();
+		if (renderingEnabled)
+		{
+			sceneManager->draw();
+		}
+	}
+
+	void Spade::startSimulation(float deltaTime)
+	{
+		std::lock_guard<std::mutex> lock(simulationMutex);
+
+		if (!simulationThread.joinable())
+		{
+			simulationThread = std::thread(&Spade::simulationLoop, this);
+		}
+
+		simulationDelta = deltaTime;
+		simulationPending = true;
+		simulationChanged.notify_all();
+	}
+
+	void Spade::waitForSimulation()
+	{
+		std::unique_lock<std::mutex> lock(simulationMutex);
+		simulationChanged.wait(lock, [this]() { return !simulationPending; });
+	}
+
+	void Spade::simulationLoop()
+	{
+		std::unique_lock<std::mutex> lock(simulationMutex);
+
+		while (true)
+		{
+			simulationChanged.wait(lock, [this]() { return simulationPending || simulationStopping; });
+
+			if (simulationStopping)
+			{
+				return;
+			}
+
+			lock.unlock();
+			simulate(simulationDelta);
+			lock.lock();
+
+			simulationPending = false;
+			simulationChanged.notify_all();
+		}
+	}
+
+	void Spade::stopSimulationThread()
+	{
+		if (!simulationThread.joinable())
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(simulationMutex);
+			simulationStopping = true;
+			simulationChanged.notify_all();
+		}
+
+		simulationThread.join();
+		simulationStopping = false;
 	}
 };